@@ -15,11 +15,67 @@
 #include <linux/slab.h>
 #include <linux/delay.h>
 #include <linux/cdev.h>
+#include <linux/mutex.h>
+#include <linux/workqueue.h>
+#include <linux/poll.h>
+#include <linux/ktime.h>
+#include <linux/fb.h>
+#include <linux/vmalloc.h>
+#include <linux/idr.h>
+#include <linux/pm_runtime.h>
+#include <linux/property.h>
+#include <linux/debugfs.h>
+#include <linux/seq_file.h>
+#include <linux/suspend.h>
+
+#if IS_ENABLED(CONFIG_SSD1306_DRM)
+#include <linux/version.h>
+#if LINUX_VERSION_CODE < KERNEL_VERSION(5, 12, 0)
+#error "CONFIG_SSD1306_DRM needs Linux 5.12 or later, use CONFIG_SSD1306_FBDEV on older kernels"
+#endif
+#include <drm/drm_atomic_helper.h>
+#include <drm/drm_damage_helper.h>
+#include <drm/drm_drv.h>
+#include <drm/drm_fb_helper.h>
+#include <drm/drm_fourcc.h>
+#include <drm/drm_gem_atomic_helper.h>
+#include <drm/drm_gem_framebuffer_helper.h>
+#include <drm/drm_gem_shmem_helper.h>
+#include <drm/drm_probe_helper.h>
+#include <drm/drm_simple_kms_helper.h>
+#endif
 
 #include "ssd1306_driver.h"
 
-/* Global driver instance for educational purposes */
-static struct ssd1306_device_context *global_ssd1306_device = NULL;
+#define CREATE_TRACE_POINTS
+#include "ssd1306_trace.h"
+
+/* mmap layout must match the shadow framebuffer */
+static_assert(SSD1306_FB_SIZE == DISPLAY_WIDTH_PIXELS * DISPLAY_TOTAL_PAGES);
+static_assert(SSD1306_TEXT_COLUMNS == MAX_CHARS_PER_LINE && SSD1306_TEXT_LINES == MAX_DISPLAY_LINES);
+
+/* Shared by all panels: one class, one major, one minor per panel */
+static struct class *ssd1306_device_class;
+static dev_t ssd1306_device_number_base;
+static DEFINE_IDA(ssd1306_panel_ida);
+static struct dentry *ssd1306_debugfs_root;
+
+/* Default idle time before runtime suspend, tunable per panel in sysfs */
+static int autosuspend_delay_ms = SSD1306_DEFAULT_AUTOSUSPEND_MS;
+module_param(autosuspend_delay_ms, int, 0444);
+MODULE_PARM_DESC(autosuspend_delay_ms, "Idle time before the panel is put to sleep, negative disables (default -1)");
+
+/* Hello/goodbye text on bring-up and removal, off to keep boot and reboot quick */
+static bool show_banners;
+module_param(show_banners, bool, 0644);
+MODULE_PARM_DESC(show_banners, "Show a banner after bring-up and hold a goodbye banner on removal (default off)");
+
+#if IS_ENABLED(CONFIG_SSD1306_FBDEV)
+/* Framebuffer flush rate for mmap'ed writes */
+static unsigned int fbdev_refresh_rate = FBDEV_DEFAULT_REFRESH_RATE;
+module_param(fbdev_refresh_rate, uint, 0444);
+MODULE_PARM_DESC(fbdev_refresh_rate, "Deferred I/O flush rate in Hz (default 10)");
+#endif
 
 /* Function prototypes */
 static int ssd1306_i2c_probe_callback(struct i2c_client *client, const struct i2c_device_id *device_id);
@@ -30,49 +86,115 @@ static ssize_t ssd1306_char_device_write(struct file *file_ptr, const char __use
                                         size_t write_count, loff_t *file_position);
 static ssize_t ssd1306_char_device_read(struct file *file_ptr, char __user *user_buffer, 
                                         size_t read_count, loff_t *file_position);
+static loff_t ssd1306_char_device_llseek(struct file *file_ptr, loff_t offset, int whence);
+static int ssd1306_char_device_mmap(struct file *file_ptr, struct vm_area_struct *vma);
+static __poll_t ssd1306_char_device_poll(struct file *file_ptr, poll_table *poll_table_ptr);
+static long ssd1306_char_device_ioctl(struct file *file_ptr, unsigned int command, 
+                                      unsigned long argument);
+static const struct dev_pm_ops ssd1306_pm_operations;
 
 /**
- * @brief Simple 5x8 font table for basic characters
- * Font data for displaying alphanumeric characters on OLED
- */
-static const uint8_t font_table_5x8[][5] = {
-    {0x00, 0x00, 0x00, 0x00, 0x00}, /* ' ' (space) */
-    {0x3E, 0x51, 0x49, 0x45, 0x3E}, /* '0' */
-    {0x00, 0x42, 0x7F, 0x40, 0x00}, /* '1' */
-    {0x42, 0x61, 0x51, 0x49, 0x46}, /* '2' */
-    {0x21, 0x41, 0x45, 0x4B, 0x31}, /* '3' */
-    {0x18, 0x14, 0x12, 0x7F, 0x10}, /* '4' */
-    {0x27, 0x45, 0x45, 0x45, 0x39}, /* '5' */
-    {0x3C, 0x4A, 0x49, 0x49, 0x30}, /* '6' */
-    {0x01, 0x71, 0x09, 0x05, 0x03}, /* '7' */
-    {0x36, 0x49, 0x49, 0x49, 0x36}, /* '8' */
-    {0x06, 0x49, 0x49, 0x29, 0x1E}, /* '9' */
-    {0x7C, 0x12, 0x11, 0x12, 0x7C}, /* 'A' */
-    {0x7F, 0x49, 0x49, 0x49, 0x36}, /* 'B' */
-    {0x3E, 0x41, 0x41, 0x41, 0x22}, /* 'C' */
-    {0x7F, 0x41, 0x41, 0x22, 0x1C}, /* 'D' */
-    {0x7F, 0x49, 0x49, 0x49, 0x41}, /* 'E' */
-    {0x7F, 0x09, 0x09, 0x09, 0x01}, /* 'F' */
-    {0x3E, 0x41, 0x49, 0x49, 0x7A}, /* 'G' */
-    {0x7F, 0x08, 0x08, 0x08, 0x7F}, /* 'H' */
-    {0x00, 0x41, 0x7F, 0x41, 0x00}, /* 'I' */
-    {0x20, 0x40, 0x41, 0x3F, 0x01}, /* 'J' */
-    {0x7F, 0x08, 0x14, 0x22, 0x41}, /* 'K' */
-    {0x7F, 0x40, 0x40, 0x40, 0x40}, /* 'L' */
-    {0x7F, 0x02, 0x0C, 0x02, 0x7F}, /* 'M' */
-    {0x7F, 0x04, 0x08, 0x10, 0x7F}, /* 'N' */
-    {0x3E, 0x41, 0x41, 0x41, 0x3E}, /* 'O' */
-    {0x7F, 0x09, 0x09, 0x09, 0x06}, /* 'P' */
-    {0x3E, 0x41, 0x51, 0x21, 0x5E}, /* 'Q' */
-    {0x7F, 0x09, 0x19, 0x29, 0x46}, /* 'R' */
-    {0x46, 0x49, 0x49, 0x49, 0x31}, /* 'S' */
-    {0x01, 0x01, 0x7F, 0x01, 0x01}, /* 'T' */
-    {0x3F, 0x40, 0x40, 0x40, 0x3F}, /* 'U' */
-    {0x1F, 0x20, 0x40, 0x20, 0x1F}, /* 'V' */
-    {0x3F, 0x40, 0x38, 0x40, 0x3F}, /* 'W' */
-    {0x63, 0x14, 0x08, 0x14, 0x63}, /* 'X' */
-    {0x07, 0x08, 0x70, 0x08, 0x07}, /* 'Y' */
-    {0x61, 0x51, 0x49, 0x45, 0x43}, /* 'Z' */
+ * @brief 5x8 font atlas for printable ASCII (0x20-0x7E)
+ * Indexed by character code - FONT_FIRST_CHAR. Each glyph is stored in
+ * SSD1306 page format (one byte per column, LSB = top row) with the
+ * spacing column included, so a character is a single 6-byte copy.
+ */
+static const uint8_t font_table_5x8[FONT_GLYPH_COUNT][FONT_CHAR_WIDTH] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, /* ' ' (space) */
+    {0x00, 0x00, 0x5F, 0x00, 0x00, 0x00}, /* '!' */
+    {0x00, 0x07, 0x00, 0x07, 0x00, 0x00}, /* '"' */
+    {0x14, 0x7F, 0x14, 0x7F, 0x14, 0x00}, /* '#' */
+    {0x24, 0x2A, 0x7F, 0x2A, 0x12, 0x00}, /* '$' */
+    {0x23, 0x13, 0x08, 0x64, 0x62, 0x00}, /* '%' */
+    {0x36, 0x49, 0x55, 0x22, 0x50, 0x00}, /* '&' */
+    {0x00, 0x05, 0x03, 0x00, 0x00, 0x00}, /* '\'' */
+    {0x00, 0x1C, 0x22, 0x41, 0x00, 0x00}, /* '(' */
+    {0x00, 0x41, 0x22, 0x1C, 0x00, 0x00}, /* ')' */
+    {0x14, 0x08, 0x3E, 0x08, 0x14, 0x00}, /* '*' */
+    {0x08, 0x08, 0x3E, 0x08, 0x08, 0x00}, /* '+' */
+    {0x00, 0x50, 0x30, 0x00, 0x00, 0x00}, /* ',' */
+    {0x08, 0x08, 0x08, 0x08, 0x08, 0x00}, /* '-' */
+    {0x00, 0x60, 0x60, 0x00, 0x00, 0x00}, /* '.' */
+    {0x20, 0x10, 0x08, 0x04, 0x02, 0x00}, /* '/' */
+    {0x3E, 0x51, 0x49, 0x45, 0x3E, 0x00}, /* '0' */
+    {0x00, 0x42, 0x7F, 0x40, 0x00, 0x00}, /* '1' */
+    {0x42, 0x61, 0x51, 0x49, 0x46, 0x00}, /* '2' */
+    {0x21, 0x41, 0x45, 0x4B, 0x31, 0x00}, /* '3' */
+    {0x18, 0x14, 0x12, 0x7F, 0x10, 0x00}, /* '4' */
+    {0x27, 0x45, 0x45, 0x45, 0x39, 0x00}, /* '5' */
+    {0x3C, 0x4A, 0x49, 0x49, 0x30, 0x00}, /* '6' */
+    {0x01, 0x71, 0x09, 0x05, 0x03, 0x00}, /* '7' */
+    {0x36, 0x49, 0x49, 0x49, 0x36, 0x00}, /* '8' */
+    {0x06, 0x49, 0x49, 0x29, 0x1E, 0x00}, /* '9' */
+    {0x00, 0x36, 0x36, 0x00, 0x00, 0x00}, /* ':' */
+    {0x00, 0x56, 0x36, 0x00, 0x00, 0x00}, /* ';' */
+    {0x08, 0x14, 0x22, 0x41, 0x00, 0x00}, /* '<' */
+    {0x14, 0x14, 0x14, 0x14, 0x14, 0x00}, /* '=' */
+    {0x00, 0x41, 0x22, 0x14, 0x08, 0x00}, /* '>' */
+    {0x02, 0x01, 0x51, 0x09, 0x06, 0x00}, /* '?' */
+    {0x32, 0x49, 0x79, 0x41, 0x3E, 0x00}, /* '@' */
+    {0x7C, 0x12, 0x11, 0x12, 0x7C, 0x00}, /* 'A' */
+    {0x7F, 0x49, 0x49, 0x49, 0x36, 0x00}, /* 'B' */
+    {0x3E, 0x41, 0x41, 0x41, 0x22, 0x00}, /* 'C' */
+    {0x7F, 0x41, 0x41, 0x22, 0x1C, 0x00}, /* 'D' */
+    {0x7F, 0x49, 0x49, 0x49, 0x41, 0x00}, /* 'E' */
+    {0x7F, 0x09, 0x09, 0x09, 0x01, 0x00}, /* 'F' */
+    {0x3E, 0x41, 0x49, 0x49, 0x7A, 0x00}, /* 'G' */
+    {0x7F, 0x08, 0x08, 0x08, 0x7F, 0x00}, /* 'H' */
+    {0x00, 0x41, 0x7F, 0x41, 0x00, 0x00}, /* 'I' */
+    {0x20, 0x40, 0x41, 0x3F, 0x01, 0x00}, /* 'J' */
+    {0x7F, 0x08, 0x14, 0x22, 0x41, 0x00}, /* 'K' */
+    {0x7F, 0x40, 0x40, 0x40, 0x40, 0x00}, /* 'L' */
+    {0x7F, 0x02, 0x0C, 0x02, 0x7F, 0x00}, /* 'M' */
+    {0x7F, 0x04, 0x08, 0x10, 0x7F, 0x00}, /* 'N' */
+    {0x3E, 0x41, 0x41, 0x41, 0x3E, 0x00}, /* 'O' */
+    {0x7F, 0x09, 0x09, 0x09, 0x06, 0x00}, /* 'P' */
+    {0x3E, 0x41, 0x51, 0x21, 0x5E, 0x00}, /* 'Q' */
+    {0x7F, 0x09, 0x19, 0x29, 0x46, 0x00}, /* 'R' */
+    {0x46, 0x49, 0x49, 0x49, 0x31, 0x00}, /* 'S' */
+    {0x01, 0x01, 0x7F, 0x01, 0x01, 0x00}, /* 'T' */
+    {0x3F, 0x40, 0x40, 0x40, 0x3F, 0x00}, /* 'U' */
+    {0x1F, 0x20, 0x40, 0x20, 0x1F, 0x00}, /* 'V' */
+    {0x3F, 0x40, 0x38, 0x40, 0x3F, 0x00}, /* 'W' */
+    {0x63, 0x14, 0x08, 0x14, 0x63, 0x00}, /* 'X' */
+    {0x07, 0x08, 0x70, 0x08, 0x07, 0x00}, /* 'Y' */
+    {0x61, 0x51, 0x49, 0x45, 0x43, 0x00}, /* 'Z' */
+    {0x00, 0x7F, 0x41, 0x41, 0x00, 0x00}, /* '[' */
+    {0x02, 0x04, 0x08, 0x10, 0x20, 0x00}, /* '\\' */
+    {0x00, 0x41, 0x41, 0x7F, 0x00, 0x00}, /* ']' */
+    {0x04, 0x02, 0x01, 0x02, 0x04, 0x00}, /* '^' */
+    {0x40, 0x40, 0x40, 0x40, 0x40, 0x00}, /* '_' */
+    {0x00, 0x01, 0x02, 0x04, 0x00, 0x00}, /* '`' */
+    {0x20, 0x54, 0x54, 0x54, 0x78, 0x00}, /* 'a' */
+    {0x7F, 0x48, 0x44, 0x44, 0x38, 0x00}, /* 'b' */
+    {0x38, 0x44, 0x44, 0x44, 0x20, 0x00}, /* 'c' */
+    {0x38, 0x44, 0x44, 0x48, 0x7F, 0x00}, /* 'd' */
+    {0x38, 0x54, 0x54, 0x54, 0x18, 0x00}, /* 'e' */
+    {0x08, 0x7E, 0x09, 0x01, 0x02, 0x00}, /* 'f' */
+    {0x0C, 0x52, 0x52, 0x52, 0x3E, 0x00}, /* 'g' */
+    {0x7F, 0x08, 0x04, 0x04, 0x78, 0x00}, /* 'h' */
+    {0x00, 0x44, 0x7D, 0x40, 0x00, 0x00}, /* 'i' */
+    {0x20, 0x40, 0x44, 0x3D, 0x00, 0x00}, /* 'j' */
+    {0x7F, 0x10, 0x28, 0x44, 0x00, 0x00}, /* 'k' */
+    {0x00, 0x41, 0x7F, 0x40, 0x00, 0x00}, /* 'l' */
+    {0x7C, 0x04, 0x18, 0x04, 0x78, 0x00}, /* 'm' */
+    {0x7C, 0x08, 0x04, 0x04, 0x78, 0x00}, /* 'n' */
+    {0x38, 0x44, 0x44, 0x44, 0x38, 0x00}, /* 'o' */
+    {0x7C, 0x14, 0x14, 0x14, 0x08, 0x00}, /* 'p' */
+    {0x08, 0x14, 0x14, 0x18, 0x7C, 0x00}, /* 'q' */
+    {0x7C, 0x08, 0x04, 0x04, 0x08, 0x00}, /* 'r' */
+    {0x48, 0x54, 0x54, 0x54, 0x20, 0x00}, /* 's' */
+    {0x04, 0x3F, 0x44, 0x40, 0x20, 0x00}, /* 't' */
+    {0x3C, 0x40, 0x40, 0x20, 0x7C, 0x00}, /* 'u' */
+    {0x1C, 0x20, 0x40, 0x20, 0x1C, 0x00}, /* 'v' */
+    {0x3C, 0x40, 0x30, 0x40, 0x3C, 0x00}, /* 'w' */
+    {0x44, 0x28, 0x10, 0x28, 0x44, 0x00}, /* 'x' */
+    {0x0C, 0x50, 0x50, 0x50, 0x3C, 0x00}, /* 'y' */
+    {0x44, 0x64, 0x54, 0x4C, 0x44, 0x00}, /* 'z' */
+    {0x00, 0x08, 0x36, 0x41, 0x00, 0x00}, /* '{' */
+    {0x00, 0x00, 0x7F, 0x00, 0x00, 0x00}, /* '|' */
+    {0x00, 0x41, 0x36, 0x08, 0x00, 0x00}, /* '}' */
+    {0x08, 0x04, 0x08, 0x10, 0x08, 0x00}, /* '~' */
 };
 
 /**
@@ -95,6 +217,16 @@ static const struct i2c_device_id ssd1306_i2c_device_id_table[] = {
 };
 MODULE_DEVICE_TABLE(i2c, ssd1306_i2c_device_id_table);
 
+/**
+ * @brief Panel sizes selectable with the device tree width/height properties
+ */
+static const struct ssd1306_panel_geometry ssd1306_panel_geometries[] = {
+    { .width = 128, .height = 64, .column_offset = 0,  .com_pins = 0x12 },
+    { .width = 128, .height = 32, .column_offset = 0,  .com_pins = 0x02 },
+    { .width = 96,  .height = 16, .column_offset = 0,  .com_pins = 0x02 },
+    { .width = 64,  .height = 48, .column_offset = 32, .com_pins = 0x12 },
+};
+
 /**
  * @brief File operations structure
  * Defines file operations for character device
@@ -105,6 +237,11 @@ static const struct file_operations ssd1306_char_device_file_operations = {
     .release = ssd1306_char_device_release,
     .write = ssd1306_char_device_write,
     .read = ssd1306_char_device_read,
+    .llseek = ssd1306_char_device_llseek,
+    .mmap = ssd1306_char_device_mmap,
+    .poll = ssd1306_char_device_poll,
+    .unlocked_ioctl = ssd1306_char_device_ioctl,
+    .compat_ioctl = compat_ptr_ioctl,
 };
 
 /**
@@ -116,12 +253,45 @@ static struct i2c_driver ssd1306_i2c_driver_instance = {
         .name = I2C_DRIVER_NAME,
         .of_match_table = ssd1306_device_tree_match_table,
         .owner = THIS_MODULE,
+        .pm = &ssd1306_pm_operations,
+        .probe_type = PROBE_PREFER_ASYNCHRONOUS,
     },
     .probe = ssd1306_i2c_probe_callback,
     .remove = ssd1306_i2c_remove_callback,
     .id_table = ssd1306_i2c_device_id_table,
 };
 
+/**
+ * @brief Account one I2C transfer in the bus statistics
+ * @param device_ctx Pointer to device context
+ * @param transfer_length Bytes on the wire including the control byte
+ * @param transmission_result Return value of i2c_master_send()
+ */
+static void ssd1306_count_i2c_transfer(struct ssd1306_device_context *device_ctx, 
+                                       size_t transfer_length, int transmission_result)
+{
+    struct ssd1306_statistics *statistics = &device_ctx->statistics;
+    
+    atomic64_inc(&statistics->i2c_transactions);
+    if (transmission_result < 0) {
+        atomic64_inc(&statistics->i2c_errors);
+    } else {
+        atomic64_add(transfer_length, &statistics->i2c_bytes_sent);
+    }
+}
+
+/**
+ * @brief Add one sample to a log2 latency histogram
+ * @param histogram Histogram with SSD1306_LATENCY_BUCKETS buckets
+ * @param latency Measured duration
+ */
+static void ssd1306_record_latency(uint32_t *histogram, ktime_t latency)
+{
+    s64 latency_us = max_t(s64, ktime_to_us(latency), 0);
+    
+    histogram[min_t(unsigned int, fls64(latency_us), SSD1306_LATENCY_BUCKETS - 1)]++;
+}
+
 /**
  * @brief Send command to SSD1306 via I2C
  * @param device_ctx Pointer to device context
@@ -135,11 +305,14 @@ static int ssd1306_send_i2c_command(struct ssd1306_device_context *device_ctx,
     int transmission_result;
     
     transmission_result = i2c_master_send(device_ctx->i2c_client_ptr, i2c_buffer, 2);
+    trace_ssd1306_command(device_ctx->i2c_client_ptr, &command_byte, 1, 
+                          min(transmission_result, 0));
+    ssd1306_count_i2c_transfer(device_ctx, sizeof(i2c_buffer), transmission_result);
     
     if (transmission_result < 0) {
-        dev_err(&device_ctx->i2c_client_ptr->dev, 
-                "Failed to send command 0x%02X, error: %d\n", 
-                command_byte, transmission_result);
+        dev_err_ratelimited(&device_ctx->i2c_client_ptr->dev, 
+                            "Failed to send command 0x%02X, error: %d\n", 
+                            command_byte, transmission_result);
         return transmission_result;
     }
     
@@ -147,420 +320,3987 @@ static int ssd1306_send_i2c_command(struct ssd1306_device_context *device_ctx,
 }
 
 /**
- * @brief Send data to SSD1306 via I2C
+ * @brief Send a control byte plus payload to SSD1306 via I2C
  * @param device_ctx Pointer to device context
- * @param data_byte Data byte to send
+ * @param control_byte I2C_CMD_PREFIX or I2C_DATA_PREFIX
+ * @param payload_buffer Command or display RAM bytes to send
+ * @param payload_length Number of bytes in payload_buffer
  * @return 0 on success, negative error code on failure
+ *
+ * Each message carries one control byte followed by as many payload bytes
+ * as the adapter accepts, so a whole page, frame or command sequence costs
+ * one START/ADDR/STOP instead of one per byte.
  */
-static int ssd1306_send_i2c_data(struct ssd1306_device_context *device_ctx, 
-                                 uint8_t data_byte)
+static int ssd1306_send_i2c_buffer(struct ssd1306_device_context *device_ctx, 
+                                   uint8_t control_byte, 
+                                   const uint8_t *payload_buffer, size_t payload_length)
 {
-    uint8_t i2c_buffer[2] = {I2C_DATA_PREFIX, data_byte};
+    uint8_t *i2c_buffer = device_ctx->i2c_transfer_buffer;
+    size_t chunk_capacity = device_ctx->i2c_max_write_length - 1;
+    size_t chunk_length;
     int transmission_result;
     
-    transmission_result = i2c_master_send(device_ctx->i2c_client_ptr, i2c_buffer, 2);
-    
-    if (transmission_result < 0) {
-        dev_err(&device_ctx->i2c_client_ptr->dev, 
-                "Failed to send data 0x%02X, error: %d\n", 
-                data_byte, transmission_result);
-        return transmission_result;
+    while (payload_length > 0) {
+        chunk_length = min(payload_length, chunk_capacity);
+        
+        i2c_buffer[0] = control_byte;
+        memcpy(&i2c_buffer[1], payload_buffer, chunk_length);
+        
+        transmission_result = i2c_master_send(device_ctx->i2c_client_ptr, 
+                                              i2c_buffer, chunk_length + 1);
+        if (control_byte == I2C_CMD_PREFIX) {
+            trace_ssd1306_command(device_ctx->i2c_client_ptr, payload_buffer, chunk_length, 
+                                  min(transmission_result, 0));
+        } else {
+            trace_ssd1306_data_burst(device_ctx->i2c_client_ptr, chunk_length, 
+                                     min(transmission_result, 0));
+        }
+        ssd1306_count_i2c_transfer(device_ctx, chunk_length + 1, transmission_result);
+        if (transmission_result < 0) {
+            dev_err_ratelimited(&device_ctx->i2c_client_ptr->dev, 
+                                "Failed to send %zu bytes (control 0x%02X), error: %d\n", 
+                                chunk_length, control_byte, transmission_result);
+            return transmission_result;
+        }
+        
+        payload_buffer += chunk_length;
+        payload_length -= chunk_length;
     }
     
     return 0;
 }
 
 /**
- * @brief Initialize SSD1306 display hardware
- * @param device_ctx Pointer to device context structure
+ * @brief Send a block of display data to SSD1306 via I2C
+ * @param device_ctx Pointer to device context
+ * @param data_buffer Display RAM bytes to send
+ * @param data_length Number of bytes in data_buffer
  * @return 0 on success, negative error code on failure
  */
-int ssd1306_initialize_display_hardware(struct ssd1306_device_context *device_ctx)
+static int ssd1306_send_i2c_data(struct ssd1306_device_context *device_ctx, 
+                                 const uint8_t *data_buffer, size_t data_length)
 {
-    dev_info(&device_ctx->i2c_client_ptr->dev, "Initializing SSD1306 display hardware\n");
-    
-    /* Wait for display to be ready */
-    msleep(100);
-    
-    /* Display OFF during initialization */
-    ssd1306_send_i2c_command(device_ctx, SSD1306_CMD_DISPLAY_OFF);
-    
-    /* Basic initialization sequence - simplified for educational purposes */
-    ssd1306_send_i2c_command(device_ctx, 0xD5); /* Set display clock divide ratio */
-    ssd1306_send_i2c_command(device_ctx, 0x80); /* Default clock setting */
-    
-    ssd1306_send_i2c_command(device_ctx, 0xA8); /* Set multiplex ratio */
-    ssd1306_send_i2c_command(device_ctx, 0x3F); /* 64 lines */
-    
-    ssd1306_send_i2c_command(device_ctx, 0xD3); /* Set display offset */
-    ssd1306_send_i2c_command(device_ctx, 0x00); /* No offset */
-    
-    ssd1306_send_i2c_command(device_ctx, 0x40); /* Set start line */
-    
-    ssd1306_send_i2c_command(device_ctx, 0x8D); /* Charge pump setting */
-    ssd1306_send_i2c_command(device_ctx, 0x14); /* Enable charge pump */
-    
-    ssd1306_send_i2c_command(device_ctx, 0x20); /* Memory addressing mode */
-    ssd1306_send_i2c_command(device_ctx, 0x00); /* Horizontal addressing */
-    
-    ssd1306_send_i2c_command(device_ctx, 0xA1); /* Set segment remap */
-    ssd1306_send_i2c_command(device_ctx, 0xC8); /* Set COM scan direction */
-    
-    ssd1306_send_i2c_command(device_ctx, 0xDA); /* Set COM pins configuration */
-    ssd1306_send_i2c_command(device_ctx, 0x12); /* Alternative COM pins */
-    
-    /* Set contrast */
-    ssd1306_send_i2c_command(device_ctx, SSD1306_CMD_SET_CONTRAST);
-    ssd1306_send_i2c_command(device_ctx, 0x80); /* Medium contrast */
-    
-    ssd1306_send_i2c_command(device_ctx, 0xD9); /* Set pre-charge period */
-    ssd1306_send_i2c_command(device_ctx, 0xF1); /* Pre-charge setting */
-    
-    ssd1306_send_i2c_command(device_ctx, 0xDB); /* Set VCOM detect */
-    ssd1306_send_i2c_command(device_ctx, 0x20); /* VCOM detect setting */
-    
-    ssd1306_send_i2c_command(device_ctx, 0xA4); /* Resume to RAM content display */
-    ssd1306_send_i2c_command(device_ctx, 0xA6); /* Normal display (not inverted) */
-    ssd1306_send_i2c_command(device_ctx, 0x2E); /* Deactivate scroll */
-    
-    /* Display ON */
-    ssd1306_send_i2c_command(device_ctx, SSD1306_CMD_DISPLAY_ON);
-    
-    /* Clear screen */
-    ssd1306_clear_display_screen(device_ctx);
-    
-    /* Set initial device state */
-    device_ctx->is_display_enabled = true;
-    device_ctx->display_brightness_level = 128;
-    device_ctx->current_cursor_line = 0;
-    device_ctx->current_cursor_column = 0;
-    
-    dev_info(&device_ctx->i2c_client_ptr->dev, 
-             "SSD1306 display hardware initialized successfully\n");
-    return 0;
+    return ssd1306_send_i2c_buffer(device_ctx, I2C_DATA_PREFIX, data_buffer, data_length);
 }
 
 /**
- * @brief Clear entire display screen
- * @param device_ctx Pointer to device context structure  
- * @return 0 on success, negative error code on failure
+ * @brief Start an empty command list
+ * @param command_list Pointer to command list
  */
-int ssd1306_clear_display_screen(struct ssd1306_device_context *device_ctx)
+static void ssd1306_command_list_init(struct ssd1306_command_list *command_list)
 {
-    int pixel_index;
-    
-    /* Set column address range to cover entire display */
-    ssd1306_send_i2c_command(device_ctx, SSD1306_CMD_SET_COLUMN_ADDR);
-    ssd1306_send_i2c_command(device_ctx, 0x00); /* Column start */
-    ssd1306_send_i2c_command(device_ctx, 0x7F); /* Column end (127) */
-    
-    /* Set page address range to cover entire display */
-    ssd1306_send_i2c_command(device_ctx, SSD1306_CMD_SET_PAGE_ADDR);
-    ssd1306_send_i2c_command(device_ctx, 0x00); /* Page start */
-    ssd1306_send_i2c_command(device_ctx, 0x07); /* Page end (7) */
-    
-    /* Send zeros to clear all pixels */
-    for (pixel_index = 0; pixel_index < (DISPLAY_WIDTH_PIXELS * DISPLAY_TOTAL_PAGES); pixel_index++) {
-        ssd1306_send_i2c_data(device_ctx, 0x00);
+    command_list->command_count = 0;
+    command_list->has_overflowed = false;
+}
+
+/**
+ * @brief Queue one command or argument byte
+ * @param command_list Pointer to command list
+ * @param command_byte Command or argument byte
+ */
+static void ssd1306_command_list_add(struct ssd1306_command_list *command_list, 
+                                     uint8_t command_byte)
+{
+    if (command_list->command_count >= SSD1306_MAX_COMMAND_LIST_SIZE) {
+        command_list->has_overflowed = true;
+        return;
     }
     
-    /* Reset cursor position */
-    device_ctx->current_cursor_line = 0;
-    device_ctx->current_cursor_column = 0;
-    
-    return 0;
+    command_list->command_bytes[command_list->command_count++] = command_byte;
 }
 
 /**
- * @brief Set cursor position on display
+ * @brief Send all queued commands in a single I2C transfer
  * @param device_ctx Pointer to device context
- * @param line_number Line number (0-7)
- * @param column_number Column number (0-20)
+ * @param command_list Pointer to command list
  * @return 0 on success, negative error code on failure
  */
-static int ssd1306_set_cursor_position(struct ssd1306_device_context *device_ctx, 
-                                       uint8_t line_number, uint8_t column_number)
+static int ssd1306_send_command_list(struct ssd1306_device_context *device_ctx, 
+                                     const struct ssd1306_command_list *command_list)
 {
-    if (line_number >= MAX_DISPLAY_LINES || column_number >= MAX_CHARS_PER_LINE) {
-        return -EINVAL;
+    if (command_list->has_overflowed) {
+        dev_err(&device_ctx->i2c_client_ptr->dev, 
+                "Command list overflow, %d bytes max\n", SSD1306_MAX_COMMAND_LIST_SIZE);
+        return -ENOSPC;
     }
     
-    /* Set column address */
-    ssd1306_send_i2c_command(device_ctx, SSD1306_CMD_SET_COLUMN_ADDR);
-    ssd1306_send_i2c_command(device_ctx, column_number * FONT_CHAR_WIDTH);
-    ssd1306_send_i2c_command(device_ctx, 127);
+    return ssd1306_send_i2c_buffer(device_ctx, I2C_CMD_PREFIX, 
+                                   command_list->command_bytes, command_list->command_count);
+}
+
+/**
+ * @brief Read the panel size from firmware and derive the geometry
+ * @param device_ctx Pointer to device context
+ * @return 0 on success, -EINVAL for an unsupported size
+ *
+ * Missing properties default to the 128x64 module.
+ */
+static int ssd1306_read_panel_geometry(struct ssd1306_device_context *device_ctx)
+{
+    struct device *dev = &device_ctx->i2c_client_ptr->dev;
+    const struct ssd1306_panel_geometry *geometry;
+    u32 panel_width = DISPLAY_WIDTH_PIXELS;
+    u32 panel_height = DISPLAY_HEIGHT_PIXELS;
+    int geometry_index;
     
-    /* Set page address */
-    ssd1306_send_i2c_command(device_ctx, SSD1306_CMD_SET_PAGE_ADDR);
-    ssd1306_send_i2c_command(device_ctx, line_number);
-    ssd1306_send_i2c_command(device_ctx, 7);
+    device_property_read_u32(dev, "width", &panel_width);
+    device_property_read_u32(dev, "height", &panel_height);
     
-    device_ctx->current_cursor_line = line_number;
-    device_ctx->current_cursor_column = column_number;
+    for (geometry_index = 0; geometry_index < ARRAY_SIZE(ssd1306_panel_geometries); geometry_index++) {
+        geometry = &ssd1306_panel_geometries[geometry_index];
+        if (geometry->width == panel_width && geometry->height == panel_height) {
+            device_ctx->panel_width = geometry->width;
+            device_ctx->panel_height = geometry->height;
+            device_ctx->panel_pages = geometry->height / 8;
+            device_ctx->panel_column_offset = geometry->column_offset;
+            device_ctx->panel_com_pins = geometry->com_pins;
+            device_ctx->text_columns = geometry->width / FONT_CHAR_WIDTH;
+            
+            dev_info(dev, "Panel geometry %ux%u\n", panel_width, panel_height);
+            return 0;
+        }
+    }
     
-    return 0;
+    dev_err(dev, "Unsupported panel geometry %ux%u\n", panel_width, panel_height);
+    return -EINVAL;
 }
 
 /**
- * @brief Write single character to display
+ * @brief Allocate the bulk transfer buffer sized to the adapter limits
  * @param device_ctx Pointer to device context
- * @param character Character to display
  * @return 0 on success, negative error code on failure
  */
-static int ssd1306_write_single_character(struct ssd1306_device_context *device_ctx, 
-                                          char character)
+static int ssd1306_setup_i2c_transfer_buffer(struct ssd1306_device_context *device_ctx)
 {
-    int font_byte_index;
-    const uint8_t *font_data_ptr;
-    
-    /* Handle newline character */
-    if (character == '\n') {
-        device_ctx->current_cursor_line++;
-        device_ctx->current_cursor_column = 0;
-        if (device_ctx->current_cursor_line >= MAX_DISPLAY_LINES) {
-            device_ctx->current_cursor_line = 0; /* Wrap to top */
-        }
-        ssd1306_set_cursor_position(device_ctx, 
-                                   device_ctx->current_cursor_line, 
-                                   device_ctx->current_cursor_column);
-        return 0;
-    }
+    struct i2c_client *client = device_ctx->i2c_client_ptr;
+    const struct i2c_adapter_quirks *adapter_quirks = client->adapter->quirks;
+    size_t max_write_length = I2C_MAX_TRANSFER_SIZE;
     
-    /* Handle line wrap */
-    if (device_ctx->current_cursor_column >= MAX_CHARS_PER_LINE) {
-        device_ctx->current_cursor_line++;
-        device_ctx->current_cursor_column = 0;
-        if (device_ctx->current_cursor_line >= MAX_DISPLAY_LINES) {
-            device_ctx->current_cursor_line = 0;
-        }
-        ssd1306_set_cursor_position(device_ctx, 
-                                   device_ctx->current_cursor_line, 
-                                   device_ctx->current_cursor_column);
+    /* Respect controllers that cannot send a full frame in one message */
+    if (adapter_quirks && adapter_quirks->max_write_len) {
+        max_write_length = min_t(size_t, max_write_length, adapter_quirks->max_write_len);
     }
     
-    /* Get font data - simple character mapping */
-    if (character >= '0' && character <= '9') {
-        font_data_ptr = font_table_5x8[character - '0' + 1]; /* +1 because space is at index 0 */
-    } else if (character >= 'A' && character <= 'Z') {
-        font_data_ptr = font_table_5x8[character - 'A' + 11];
-    } else if (character >= 'a' && character <= 'z') {
-        font_data_ptr = font_table_5x8[character - 'a' + 11]; /* Use uppercase font */
-    } else {
-        font_data_ptr = font_table_5x8[0]; /* Space for unknown characters */
+    if (max_write_length < 2) {
+        dev_err(&client->dev, "Adapter write limit %zu too small\n", max_write_length);
+        return -EINVAL;
     }
     
-    /* Send font data to display */
-    for (font_byte_index = 0; font_byte_index < 5; font_byte_index++) {
-        ssd1306_send_i2c_data(device_ctx, font_data_ptr[font_byte_index]);
+    device_ctx->i2c_transfer_buffer = devm_kzalloc(&client->dev, max_write_length, GFP_KERNEL);
+    if (!device_ctx->i2c_transfer_buffer) {
+        return -ENOMEM;
     }
     
-    /* Add space between characters */
-    ssd1306_send_i2c_data(device_ctx, 0x00);
-    
-    device_ctx->current_cursor_column++;
-    
+    device_ctx->i2c_max_write_length = max_write_length;
+    dev_info(&client->dev, "I2C bulk transfer size: %zu bytes\n", max_write_length);
     return 0;
 }
 
 /**
- * @brief Write text string to display
- * @param device_ctx Pointer to device context structure
- * @param text_string Null-terminated text string to display
- * @return 0 on success, negative error code on failure
+ * @brief Grow a dirty column range to cover first_column..last_column
+ * @param dirty_range Range to extend
+ * @param first_column First changed column (inclusive)
+ * @param last_column Last changed column (inclusive)
  */
-int ssd1306_write_text_to_display(struct ssd1306_device_context *device_ctx, 
-                                  const char *text_string)
+static void ssd1306_extend_dirty_range(struct ssd1306_dirty_column_range *dirty_range, 
+                                       uint8_t first_column, uint8_t last_column)
 {
-    while (*text_string) {
-        ssd1306_write_single_character(device_ctx, *text_string++);
+    if (!dirty_range->is_dirty) {
+        dirty_range->first_column = first_column;
+        dirty_range->last_column = last_column;
+        dirty_range->is_dirty = true;
+        return;
     }
-    return 0;
+    
+    dirty_range->first_column = min(dirty_range->first_column, first_column);
+    dirty_range->last_column = max(dirty_range->last_column, last_column);
 }
 
 /**
- * @brief Set display brightness level
- * @param device_ctx Pointer to device context structure
- * @param brightness_level Brightness level (0-255)
- * @return 0 on success, negative error code on failure
+ * @brief Mark a column range of one page as needing a flush
+ * @param device_ctx Pointer to device context
+ * @param page_number Page number (0-7)
+ * @param first_column First changed column (inclusive)
+ * @param last_column Last changed column (inclusive)
  */
-int ssd1306_set_display_brightness(struct ssd1306_device_context *device_ctx, 
-                                   uint8_t brightness_level)
+static void ssd1306_mark_page_dirty(struct ssd1306_device_context *device_ctx, 
+                                    uint8_t page_number, 
+                                    uint8_t first_column, uint8_t last_column)
 {
-    ssd1306_send_i2c_command(device_ctx, SSD1306_CMD_SET_CONTRAST);
-    ssd1306_send_i2c_command(device_ctx, brightness_level);
-    device_ctx->display_brightness_level = brightness_level;
-    return 0;
+    ssd1306_extend_dirty_range(&device_ctx->page_dirty_ranges[page_number], 
+                               first_column, last_column);
 }
 
-/* Character Device File Operations Implementation */
+/**
+ * @brief Map a visible text/pixel page row to its panel RAM page
+ * @param device_ctx Pointer to device context
+ * @param logical_page Page as seen on screen, 0 = top
+ * @return Panel RAM page currently shown at that position
+ *
+ * The display start line register rotates RAM pages on screen when text
+ * scrolls; the shadow framebuffer is kept in RAM order. The rotation is
+ * over all RAM pages, panels shorter than 64 rows show a window of it.
+ */
+static inline uint8_t ssd1306_physical_page(const struct ssd1306_device_context *device_ctx, 
+                                            uint8_t logical_page)
+{
+    return (logical_page + device_ctx->scroll_page_offset) % DISPLAY_TOTAL_PAGES;
+}
 
 /**
- * @brief Character device open operation
- * @param inode_ptr Pointer to inode structure
- * @param file_ptr Pointer to file structure
- * @return 0 on success, negative error code on failure
+ * @brief Lock the RAM page row shown at a screen position
+ * @param device_ctx Pointer to device context, display_lock held for reading
+ * @param logical_page Page as seen on screen
  */
-static int ssd1306_char_device_open(struct inode *inode_ptr, struct file *file_ptr)
+static void ssd1306_lock_page_row(struct ssd1306_device_context *device_ctx, 
+                                  uint8_t logical_page)
 {
-    file_ptr->private_data = global_ssd1306_device;
-    dev_info(&global_ssd1306_device->i2c_client_ptr->dev, 
-             "SSD1306 character device opened\n");
-    return 0;
+    mutex_lock(&device_ctx->page_row_locks[ssd1306_physical_page(device_ctx, logical_page)]);
 }
 
 /**
- * @brief Character device release operation
- * @param inode_ptr Pointer to inode structure
- * @param file_ptr Pointer to file structure
- * @return 0 on success, negative error code on failure
+ * @brief Unlock a page row taken with ssd1306_lock_page_row()
+ * @param device_ctx Pointer to device context
+ * @param logical_page Page as seen on screen
  */
-static int ssd1306_char_device_release(struct inode *inode_ptr, struct file *file_ptr)
+static void ssd1306_unlock_page_row(struct ssd1306_device_context *device_ctx, 
+                                    uint8_t logical_page)
 {
-    dev_info(&global_ssd1306_device->i2c_client_ptr->dev, 
-             "SSD1306 character device closed\n");
-    return 0;
+    mutex_unlock(&device_ctx->page_row_locks[ssd1306_physical_page(device_ctx, logical_page)]);
 }
 
 /**
- * @brief Character device write operation
- * @param file_ptr Pointer to file structure
- * @param user_buffer User space buffer containing data to write
- * @param write_count Number of bytes to write
- * @param file_position File position pointer
- * @return Number of bytes written or negative error code
+ * @brief Mark the visible framebuffer as needing a flush
+ * @param device_ctx Pointer to device context
+ *
+ * Used when panel RAM content is unknown, e.g. right after power-on.
+ * RAM pages outside the panel window are only written once text
+ * scrolling brings them into view.
  */
-static ssize_t ssd1306_char_device_write(struct file *file_ptr, const char __user *user_buffer, 
-                                         size_t write_count, loff_t *file_position)
+static void ssd1306_invalidate_framebuffer(struct ssd1306_device_context *device_ctx)
 {
-    struct ssd1306_device_context *device_ctx = file_ptr->private_data;
-    char message_buffer[MAX_MESSAGE_BUFFER_SIZE];
-    size_t safe_write_count = min(write_count, (size_t)(MAX_MESSAGE_BUFFER_SIZE - 1));
+    uint8_t physical_page;
+    int page_index;
     
-    if (copy_from_user(message_buffer, user_buffer, safe_write_count)) {
-        return -EFAULT;
+    device_ctx->unsynced_page_mask = GENMASK(DISPLAY_TOTAL_PAGES - 1, 0);
+    for (page_index = 0; page_index < device_ctx->panel_pages; page_index++) {
+        physical_page = ssd1306_physical_page(device_ctx, page_index);
+        ssd1306_mark_page_dirty(device_ctx, physical_page, 0, device_ctx->panel_width - 1);
+        device_ctx->unsynced_page_mask &= ~BIT(physical_page);
     }
-    
-    message_buffer[safe_write_count] = '\0';
-    
-    dev_info(&device_ctx->i2c_client_ptr->dev, 
-             "Writing text to display: %s\n", message_buffer);
-    
-    /* Clear screen and write new text */
-    ssd1306_clear_display_screen(device_ctx);
-    ssd1306_set_cursor_position(device_ctx, 0, 0);
-    ssd1306_write_text_to_display(device_ctx, message_buffer);
-    
-    /* Save message to device buffer */
-    strncpy(device_ctx->message_display_buffer, message_buffer, MAX_MESSAGE_BUFFER_SIZE - 1);
-    device_ctx->message_display_buffer[MAX_MESSAGE_BUFFER_SIZE - 1] = '\0';
-    
-    return safe_write_count;
 }
 
 /**
- * @brief Character device read operation
- * @param file_ptr Pointer to file structure
- * @param user_buffer User space buffer to read data into
- * @param read_count Number of bytes to read
- * @param file_position File position pointer
- * @return Number of bytes read or negative error code
+ * @brief Schedule RAM pages that just scrolled into view and were never written
+ * @param device_ctx Pointer to device context
  */
-static ssize_t ssd1306_char_device_read(struct file *file_ptr, char __user *user_buffer, 
-                                        size_t read_count, loff_t *file_position)
+static void ssd1306_sync_exposed_pages(struct ssd1306_device_context *device_ctx)
 {
-    struct ssd1306_device_context *device_ctx = file_ptr->private_data;
-    size_t buffer_length = strlen(device_ctx->message_display_buffer);
+    uint8_t physical_page;
+    int page_index;
     
-    if (*file_position >= buffer_length) {
-        return 0; /* End of file */
-    }
-    
-    if (read_count > buffer_length - *file_position) {
-        read_count = buffer_length - *file_position;
-    }
-    
-    if (copy_to_user(user_buffer, device_ctx->message_display_buffer + *file_position, read_count)) {
-        return -EFAULT;
+    for (page_index = 0; page_index < device_ctx->panel_pages; page_index++) {
+        physical_page = ssd1306_physical_page(device_ctx, page_index);
+        if (device_ctx->unsynced_page_mask & BIT(physical_page)) {
+            ssd1306_mark_page_dirty(device_ctx, physical_page, 0, device_ctx->panel_width - 1);
+            device_ctx->unsynced_page_mask &= ~BIT(physical_page);
+        }
     }
-    
-    *file_position += read_count;
-    return read_count;
 }
 
 /**
- * @brief Create character device file node
+ * @brief Reset the character cell grid to a blank screen
  * @param device_ctx Pointer to device context
- * @return 0 on success, negative error code on failure
+ *
+ * Call after the shadow framebuffer has been cleared.
  */
-static int ssd1306_create_character_device(struct ssd1306_device_context *device_ctx)
+static void ssd1306_reset_text_cells(struct ssd1306_device_context *device_ctx)
 {
-    int result = 0;
-    
-    dev_info(&device_ctx->i2c_client_ptr->dev, 
-             "Creating SSD1306 character device\n");
+    memset(device_ctx->text_cells, ' ', sizeof(device_ctx->text_cells));
+    memset(device_ctx->text_line_valid, true, sizeof(device_ctx->text_line_valid));
+}
+
+/**
+ * @brief Forget the character grid after whole-screen pixel drawing
+ * @param device_ctx Pointer to device context, display_lock held for writing
+ */
+static void ssd1306_invalidate_text_cells(struct ssd1306_device_context *device_ctx)
+{
+    memset(device_ctx->text_line_valid, false, sizeof(device_ctx->text_line_valid));
+}
+
+/**
+ * @brief Check that every visible text line still matches the grid
+ * @param device_ctx Pointer to device context
+ * @return true if no line has been drawn over
+ */
+static bool ssd1306_text_cells_valid(const struct ssd1306_device_context *device_ctx)
+{
+    int line_index;
     
-    /* Allocate character device region */
-    result = alloc_chrdev_region(&device_ctx->char_device_number, 0, 1, DEVICE_NAME);
-    if (result < 0) {
-        dev_err(&device_ctx->i2c_client_ptr->dev, 
-                "Failed to allocate character device region: %d\n", result);
-        goto allocation_failed;
+    for (line_index = 0; line_index < device_ctx->panel_pages; line_index++) {
+        if (!device_ctx->text_line_valid[line_index]) {
+            return false;
+        }
     }
+    return true;
+}
+
+/**
+ * @brief Copy columns into one page buffer, tracking what changed
+ * @param page_data Destination page (128 bytes)
+ * @param dirty_range Dirty range of that page to extend
+ * @param first_column First destination column
+ * @param column_data Page-format bytes to store
+ * @param column_count Number of bytes in column_data
+ *
+ * Only the span between the first and last byte that actually differs is
+ * marked dirty, so rewriting identical content costs nothing on the bus.
+ */
+static void ssd1306_copy_changed_columns(uint8_t *page_data, 
+                                         struct ssd1306_dirty_column_range *dirty_range, 
+                                         uint8_t first_column, 
+                                         const uint8_t *column_data, size_t column_count)
+{
+    size_t first_changed = 0;
+    size_t last_changed;
     
-    dev_info(&device_ctx->i2c_client_ptr->dev, 
-             "Character device allocated: major=%d, minor=%d\n",
-             MAJOR(device_ctx->char_device_number), 
-             MINOR(device_ctx->char_device_number));
-    
-    /* Create device class */
-    device_ctx->char_device_class = class_create(THIS_MODULE, DEVICE_CLASS_NAME);
-    if (IS_ERR(device_ctx->char_device_class)) {
-        result = PTR_ERR(device_ctx->char_device_class);
-        dev_err(&device_ctx->i2c_client_ptr->dev, 
-                "Failed to create device class: %d\n", result);
-        goto class_creation_failed;
+    page_data += first_column;
+    while (first_changed < column_count && page_data[first_changed] == column_data[first_changed]) {
+        first_changed++;
     }
-    
-    /* Create device node */
-    device_ctx->char_device_node = device_create(device_ctx->char_device_class, NULL, 
-                                                 device_ctx->char_device_number, 
-                                                 NULL, 
-                                                 DEVICE_NAME);
-    if (IS_ERR(device_ctx->char_device_node)) {
-        result = PTR_ERR(device_ctx->char_device_node);
-        dev_err(&device_ctx->i2c_client_ptr->dev, 
-                "Failed to create device node: %d\n", result);
-        goto device_creation_failed;
+    if (first_changed == column_count) {
+        return; /* Nothing changed */
     }
     
-    /* Initialize and add character device */
-    cdev_init(&device_ctx->char_device_cdev, &ssd1306_char_device_file_operations);
-    device_ctx->char_device_cdev.owner = THIS_MODULE;
-    
-    result = cdev_add(&device_ctx->char_device_cdev, device_ctx->char_device_number, 1);
-    if (result) {
-        dev_err(&device_ctx->i2c_client_ptr->dev, 
-                "Failed to add character device: %d\n", result);
-        goto cdev_add_failed;
+    last_changed = column_count - 1;
+    while (page_data[last_changed] == column_data[last_changed]) {
+        last_changed--;
     }
     
-    dev_info(&device_ctx->i2c_client_ptr->dev, 
-             "Character device created successfully: /dev/%s\n", DEVICE_NAME);
-    return 0;
-    
-    /* Error cleanup */
-cdev_add_failed:
-    device_destroy(device_ctx->char_device_class, device_ctx->char_device_number);
-device_creation_failed:
-    class_destroy(device_ctx->char_device_class);
-class_creation_failed:
-    unregister_chrdev_region(device_ctx->char_device_number, 1);
-allocation_failed:
-    return result;
+    memcpy(&page_data[first_changed], &column_data[first_changed], 
+           last_changed - first_changed + 1);
+    ssd1306_extend_dirty_range(dirty_range, first_column + first_changed, 
+                               first_column + last_changed);
 }
 
 /**
- * @brief I2C probe callback function
+ * @brief Page producers draw on: the back buffer when double buffered, else the shadow
+ * @param device_ctx Pointer to device context
+ * @param page_number On-screen page number
+ * @return Pointer to the 128-byte page
+ */
+static uint8_t *ssd1306_render_page(struct ssd1306_device_context *device_ctx, 
+                                    uint8_t page_number)
+{
+    uint8_t physical_page = ssd1306_physical_page(device_ctx, page_number);
+    
+    if (device_ctx->is_double_buffered) {
+        return device_ctx->back_framebuffer[physical_page];
+    }
+    return device_ctx->display_framebuffer[physical_page];
+}
+
+/**
+ * @brief Copy columns into the render target, tracking what changed
+ * @param device_ctx Pointer to device context
+ * @param page_number On-screen page number (0-7)
+ * @param first_column First destination column
+ * @param column_data Page-format bytes to store
+ * @param column_count Number of bytes in column_data
+ *
+ * Without double buffering this is the shadow framebuffer and changes
+ * become dirty for the flush engine; otherwise they wait in the back
+ * buffer for SSD1306_IOCTL_FLIP.
+ */
+static void ssd1306_update_framebuffer_columns(struct ssd1306_device_context *device_ctx, 
+                                               uint8_t page_number, uint8_t first_column, 
+                                               const uint8_t *column_data, size_t column_count)
+{
+    uint8_t physical_page = ssd1306_physical_page(device_ctx, page_number);
+    struct ssd1306_dirty_column_range *dirty_range = device_ctx->is_double_buffered ? 
+        &device_ctx->back_dirty_ranges[physical_page] : &device_ctx->page_dirty_ranges[physical_page];
+    
+    ssd1306_copy_changed_columns(ssd1306_render_page(device_ctx, page_number), dirty_range, 
+                                 first_column, column_data, column_count);
+}
+
+/**
+ * @brief Load the on-screen content into the compose buffer
+ * @param device_ctx Pointer to device context
+ *
+ * Undoes the scroll rotation so the compose buffer is in screen order.
+ */
+static void ssd1306_load_compose_framebuffer(struct ssd1306_device_context *device_ctx)
+{
+    int page_index;
+    
+    for (page_index = 0; page_index < device_ctx->panel_pages; page_index++) {
+        memcpy(device_ctx->compose_framebuffer[page_index], 
+               ssd1306_render_page(device_ctx, page_index), device_ctx->panel_width);
+    }
+}
+
+/**
+ * @brief Commit the compose buffer into the shadow framebuffer
+ * @param device_ctx Pointer to device context
+ *
+ * Text scrolled while rendering advances the start line first, so lines
+ * that only moved up map onto unchanged RAM pages and are not resent.
+ */
+static void ssd1306_commit_compose_framebuffer(struct ssd1306_device_context *device_ctx)
+{
+    int page_index;
+    
+    /*
+     * The ticker scrolls a fixed RAM page range, and a back buffer must
+     * not move under the visible frame, so in both cases the mapping
+     * stays put and scrolled text is simply redrawn.
+     */
+    if (device_ctx->pending_scroll_lines && 
+        device_ctx->ticker_config.direction == SSD1306_TICKER_OFF && 
+        !device_ctx->is_double_buffered) {
+        device_ctx->scroll_page_offset = (device_ctx->scroll_page_offset + 
+                                          device_ctx->pending_scroll_lines) % DISPLAY_TOTAL_PAGES;
+        ssd1306_sync_exposed_pages(device_ctx);
+    }
+    device_ctx->pending_scroll_lines = 0;
+    
+    for (page_index = 0; page_index < device_ctx->panel_pages; page_index++) {
+        ssd1306_update_framebuffer_columns(device_ctx, page_index, 0, 
+                                           device_ctx->compose_framebuffer[page_index], 
+                                           device_ctx->panel_width);
+    }
+}
+
+/**
+ * @brief Check whether a RAM page is scrolled by the running panel ticker
+ * @param device_ctx Pointer to device context
+ * @param page_index RAM page
+ * @return true if the page lies in the ticker's page range
+ *
+ * The range is relative to the display start line, so after a text
+ * scroll it may wrap past the last RAM page (first page > last page).
+ * Caller holds bus_lock.
+ */
+static bool ssd1306_page_in_panel_ticker(struct ssd1306_device_context *device_ctx, 
+                                         int page_index)
+{
+    uint8_t first_page = device_ctx->panel_ticker_first_page;
+    uint8_t last_page = device_ctx->panel_ticker_last_page;
+    
+    if (first_page <= last_page) {
+        return page_index >= first_page && page_index <= last_page;
+    }
+    return page_index >= first_page || page_index <= last_page;
+}
+
+/**
+ * @brief Check whether the panel ticker must stop for this flush
+ * @param device_ctx Pointer to device context
+ * @return true if the running scroll has to be deactivated
+ *
+ * GDDRAM must not be written while the scroll engine runs, and the
+ * engine leaves the scrolled pages shifted once stopped. Caller holds
+ * bus_lock and display_lock for reading; a row dirtied after the check
+ * queues its own flush, which stops the ticker then.
+ */
+static bool ssd1306_ticker_needs_stop(struct ssd1306_device_context *device_ctx)
+{
+    int page_index;
+    
+    if (device_ctx->panel_ticker.direction == SSD1306_TICKER_OFF) {
+        return false;
+    }
+    
+    if (memcmp(&device_ctx->panel_ticker, &device_ctx->ticker_config, 
+               sizeof(device_ctx->panel_ticker)) ||
+        device_ctx->scroll_page_offset * 8 != device_ctx->panel_start_line) {
+        return true;
+    }
+    
+    for (page_index = 0; page_index < DISPLAY_TOTAL_PAGES; page_index++) {
+        if (device_ctx->page_dirty_ranges[page_index].is_dirty) {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+/**
+ * @brief Encode a ticker frame interval for the scroll setup command
+ * @param frame_interval Frames per step
+ * @return 3-bit interval code, or negative error code if unsupported
+ */
+static int ssd1306_ticker_interval_code(uint32_t frame_interval)
+{
+    static const uint16_t interval_frames[] = { 5, 64, 128, 256, 3, 4, 25, 2 };
+    int code;
+    
+    for (code = 0; code < ARRAY_SIZE(interval_frames); code++) {
+        if (interval_frames[code] == frame_interval) {
+            return code;
+        }
+    }
+    
+    return -EINVAL;
+}
+
+/**
+ * @brief Start the hardware horizontal scroll on the panel
+ * @param device_ctx Pointer to device context
+ * @param ticker Validated ticker configuration
+ * @param start_line Display start line the page range is relative to
+ * @return 0 on success, negative error code on failure
+ *
+ * Caller holds bus_lock.
+ */
+static int ssd1306_start_panel_ticker(struct ssd1306_device_context *device_ctx, 
+                                      const struct ssd1306_ticker *ticker, uint8_t start_line)
+{
+    struct ssd1306_command_list scroll_commands;
+    uint8_t first_page = (ticker->first_page + start_line / 8) % DISPLAY_TOTAL_PAGES;
+    uint8_t last_page = (ticker->last_page + start_line / 8) % DISPLAY_TOTAL_PAGES;
+    int result;
+    
+    ssd1306_command_list_init(&scroll_commands);
+    ssd1306_command_list_add(&scroll_commands, ticker->direction == SSD1306_TICKER_LEFT ? 
+                             SSD1306_CMD_SCROLL_LEFT : SSD1306_CMD_SCROLL_RIGHT);
+    ssd1306_command_list_add(&scroll_commands, 0x00); /* Dummy byte */
+    ssd1306_command_list_add(&scroll_commands, first_page);
+    ssd1306_command_list_add(&scroll_commands, ssd1306_ticker_interval_code(ticker->frame_interval));
+    ssd1306_command_list_add(&scroll_commands, last_page);
+    ssd1306_command_list_add(&scroll_commands, 0x00); /* Dummy byte */
+    ssd1306_command_list_add(&scroll_commands, 0xFF); /* Dummy byte */
+    ssd1306_command_list_add(&scroll_commands, SSD1306_CMD_SCROLL_START);
+    
+    result = ssd1306_send_command_list(device_ctx, &scroll_commands);
+    if (result) {
+        return result;
+    }
+    
+    device_ctx->panel_ticker = *ticker;
+    device_ctx->panel_ticker_first_page = first_page;
+    device_ctx->panel_ticker_last_page = last_page;
+    return 0;
+}
+
+/**
+ * @brief Mark the panel state as lost and queue a background re-init
+ * @param device_ctx Pointer to device context
+ *
+ * Called after a failed transfer with bus_lock held. Until the recovery
+ * worker succeeds, flushes leave the shadow dirty instead of retrying on
+ * a broken bus; writers only ever touch the shadow and never wait for it.
+ * A round that gave up after SSD1306_RECOVERY_MAX_ATTEMPTS starts over
+ * from the initial delay.
+ */
+static void ssd1306_schedule_panel_recovery(struct ssd1306_device_context *device_ctx)
+{
+    if (!device_ctx->panel_needs_reinit) {
+        dev_warn(&device_ctx->i2c_client_ptr->dev, 
+                 "Panel transfer failed, re-initializing in background\n");
+    }
+    device_ctx->panel_needs_reinit = true;
+    
+    if (device_ctx->recovery_attempts >= SSD1306_RECOVERY_MAX_ATTEMPTS) {
+        device_ctx->recovery_attempts = 0;
+        device_ctx->recovery_delay_ms = SSD1306_RECOVERY_INITIAL_DELAY_MS;
+    }
+    
+    queue_delayed_work(device_ctx->flush_workqueue, &device_ctx->recovery_work, 
+                       msecs_to_jiffies(device_ctx->recovery_delay_ms));
+}
+
+/**
+ * @brief Bytes on the wire for one payload sent through ssd1306_send_i2c_buffer()
+ * @param device_ctx Pointer to device context
+ * @param payload_length Command or data bytes
+ * @return Payload plus address and control byte of every message it is split into
+ */
+static size_t ssd1306_transfer_cost(const struct ssd1306_device_context *device_ctx, 
+                                    size_t payload_length)
+{
+    size_t chunk_capacity = device_ctx->i2c_max_write_length - 1;
+    
+    return payload_length + DIV_ROUND_UP(payload_length, chunk_capacity) * I2C_MESSAGE_OVERHEAD;
+}
+
+/**
+ * @brief Queue an addressing mode switch unless the panel is already in it
+ * @param device_ctx Pointer to device context, bus_lock held
+ * @param command_list Command list to extend
+ * @param addressing_mode SSD1306_ADDRESSING_*
+ */
+static void ssd1306_add_addressing_mode(struct ssd1306_device_context *device_ctx, 
+                                        struct ssd1306_command_list *command_list, 
+                                        uint8_t addressing_mode)
+{
+    if (device_ctx->panel_addressing_mode != addressing_mode) {
+        ssd1306_command_list_add(command_list, SSD1306_CMD_SET_ADDRESSING_MODE);
+        ssd1306_command_list_add(command_list, addressing_mode);
+    }
+}
+
+/**
+ * @brief Pick the cheapest way to send the snapshot's dirty spans
+ * @param device_ctx Pointer to device context, bus_lock held
+ * @param snapshot Snapshot with page_ranges filled in
+ *
+ * Page addressing costs three command bytes per dirty page but sends
+ * only the dirty columns. One horizontal window costs six command bytes
+ * and a single burst but also resends clean columns inside it, so it
+ * wins once many pages are dirty across similar columns. A mode switch
+ * adds two bytes to the first command message.
+ */
+static void ssd1306_plan_flush(const struct ssd1306_device_context *device_ctx, 
+                               struct ssd1306_flush_snapshot *snapshot)
+{
+    struct ssd1306_flush_plan *plan = &snapshot->plan;
+    const struct ssd1306_dirty_column_range *dirty_range;
+    size_t horizontal_switch_cost = 
+        device_ctx->panel_addressing_mode == SSD1306_ADDRESSING_HORIZONTAL ? 0 : 2;
+    size_t page_cost = device_ctx->panel_addressing_mode == SSD1306_ADDRESSING_PAGE ? 0 : 2;
+    size_t window_cost;
+    size_t span_length;
+    int page_index;
+    
+    plan->strategy = SSD1306_FLUSH_PAGE_ADDRESSING;
+    plan->naive_cost = horizontal_switch_cost;
+    plan->first_page = DISPLAY_TOTAL_PAGES;
+    plan->first_column = DISPLAY_WIDTH_PIXELS;
+    plan->last_page = 0;
+    plan->last_column = 0;
+    
+    for (page_index = 0; page_index < DISPLAY_TOTAL_PAGES; page_index++) {
+        dirty_range = &snapshot->page_ranges[page_index];
+        if (!dirty_range->is_dirty) {
+            continue;
+        }
+        
+        span_length = dirty_range->last_column - dirty_range->first_column + 1;
+        page_cost += ssd1306_transfer_cost(device_ctx, 3) + 
+                     ssd1306_transfer_cost(device_ctx, span_length);
+        plan->naive_cost += ssd1306_transfer_cost(device_ctx, 6) + 
+                            ssd1306_transfer_cost(device_ctx, span_length);
+        
+        plan->first_page = min_t(uint8_t, plan->first_page, page_index);
+        plan->last_page = page_index;
+        plan->first_column = min(plan->first_column, dirty_range->first_column);
+        plan->last_column = max(plan->last_column, dirty_range->last_column);
+    }
+    
+    if (plan->first_page > plan->last_page) {
+        plan->cost = 0;
+        plan->naive_cost = 0;
+        return; /* Nothing dirty */
+    }
+    
+    window_cost = horizontal_switch_cost + ssd1306_transfer_cost(device_ctx, 6) + 
+                  ssd1306_transfer_cost(device_ctx, 
+                                        (plan->last_column - plan->first_column + 1) * 
+                                        (plan->last_page - plan->first_page + 1));
+    
+    plan->cost = page_cost;
+    if (window_cost < page_cost) {
+        plan->strategy = SSD1306_FLUSH_WINDOW;
+        plan->cost = window_cost;
+    }
+}
+
+/**
+ * @brief Send the snapshot as one horizontal window
+ * @param device_ctx Pointer to device context, bus_lock held
+ * @param snapshot Snapshot planned as SSD1306_FLUSH_WINDOW
+ * @return Number of data bytes sent, or negative error code
+ */
+static ssize_t ssd1306_send_flush_window(struct ssd1306_device_context *device_ctx, 
+                                         struct ssd1306_flush_snapshot *snapshot)
+{
+    const struct ssd1306_flush_plan *plan = &snapshot->plan;
+    struct ssd1306_command_list window_commands;
+    size_t window_width = plan->last_column - plan->first_column + 1;
+    size_t window_length = 0;
+    int page_index;
+    int result;
+    
+    ssd1306_command_list_init(&window_commands);
+    ssd1306_add_addressing_mode(device_ctx, &window_commands, SSD1306_ADDRESSING_HORIZONTAL);
+    ssd1306_command_list_add(&window_commands, SSD1306_CMD_SET_COLUMN_ADDR);
+    ssd1306_command_list_add(&window_commands, device_ctx->panel_column_offset + plan->first_column);
+    ssd1306_command_list_add(&window_commands, device_ctx->panel_column_offset + plan->last_column);
+    ssd1306_command_list_add(&window_commands, SSD1306_CMD_SET_PAGE_ADDR);
+    ssd1306_command_list_add(&window_commands, plan->first_page);
+    ssd1306_command_list_add(&window_commands, plan->last_page);
+    
+    result = ssd1306_send_command_list(device_ctx, &window_commands);
+    if (result) {
+        return result;
+    }
+    device_ctx->panel_addressing_mode = SSD1306_ADDRESSING_HORIZONTAL;
+    
+    /* The window wraps page by page, so rows are laid out back to back */
+    for (page_index = plan->first_page; page_index <= plan->last_page; page_index++) {
+        memcpy(&snapshot->window_data[window_length], 
+               &snapshot->page_data[page_index][plan->first_column], window_width);
+        window_length += window_width;
+    }
+    
+    result = ssd1306_send_i2c_data(device_ctx, snapshot->window_data, window_length);
+    if (result) {
+        return result;
+    }
+    return window_length;
+}
+
+/**
+ * @brief Send dirty framebuffer regions to the display
+ * @param device_ctx Pointer to device context structure
+ * @return 0 on success, negative error code on failure
+ *
+ * Dirty spans are snapshotted row by row under a read-held display_lock
+ * and sent with only bus_lock held, so writers can keep updating the
+ * shadow while the bus is busy and rows dirtied by different writers
+ * merge into one pass. ssd1306_plan_flush() then picks page addressing
+ * for the dirty spans alone or one horizontal window around all of them,
+ * whichever costs fewer bytes on the bus. Caller holds bus_lock.
+ */
+static int ssd1306_flush_dirty_pages(struct ssd1306_device_context *device_ctx)
+{
+    struct ssd1306_flush_snapshot *snapshot = &device_ctx->flush_snapshot;
+    struct ssd1306_dirty_column_range *dirty_range;
+    struct ssd1306_command_list window_commands;
+    unsigned int dirty_page_count = 0;
+    size_t snapshot_bytes = 0;
+    size_t transferred_bytes = 0;
+    size_t span_length;
+    ssize_t window_result;
+    uint8_t span_column;
+    uint64_t transactions_before;
+    ktime_t flush_start_time;
+    bool stop_ticker;
+    int page_index;
+    int retry_index;
+    int result = 0;
+    
+    /* Take the latest content, writers arriving later queue another flush */
+    down_read(&device_ctx->display_lock);
+    snapshot->frame_sequence = atomic64_read(&device_ctx->frame_sequence_submitted);
+    snapshot->oldest_write_time = atomic64_xchg(&device_ctx->oldest_pending_write, 0);
+    snapshot->display_start_line = device_ctx->scroll_page_offset * 8;
+    snapshot->ticker = device_ctx->ticker_config;
+    
+    stop_ticker = ssd1306_ticker_needs_stop(device_ctx);
+    
+    for (page_index = 0; page_index < DISPLAY_TOTAL_PAGES; page_index++) {
+        dirty_range = &device_ctx->page_dirty_ranges[page_index];
+        mutex_lock(&device_ctx->page_row_locks[page_index]);
+        
+        /* Stopped scroll leaves its pages shifted in RAM, rewrite them in full */
+        if (stop_ticker && ssd1306_page_in_panel_ticker(device_ctx, page_index)) {
+            ssd1306_mark_page_dirty(device_ctx, page_index, 0, device_ctx->panel_width - 1);
+        }
+        
+        /* Whole rows, a window may also cover clean columns and pages */
+        snapshot->page_ranges[page_index] = *dirty_range;
+        memcpy(snapshot->page_data[page_index], device_ctx->display_framebuffer[page_index], 
+               device_ctx->panel_width);
+        if (dirty_range->is_dirty) {
+            span_length = dirty_range->last_column - dirty_range->first_column + 1;
+            dirty_range->is_dirty = false;
+            dirty_page_count++;
+            snapshot_bytes += span_length;
+        }
+        mutex_unlock(&device_ctx->page_row_locks[page_index]);
+    }
+    up_read(&device_ctx->display_lock);
+    
+    ssd1306_plan_flush(device_ctx, snapshot);
+    
+    trace_ssd1306_flush_start(device_ctx->i2c_client_ptr, snapshot->frame_sequence, 
+                              dirty_page_count, snapshot_bytes);
+    transactions_before = atomic64_read(&device_ctx->statistics.i2c_transactions);
+    flush_start_time = ktime_get();
+    
+    if (stop_ticker) {
+        result = ssd1306_send_i2c_command(device_ctx, SSD1306_CMD_SCROLL_STOP);
+        if (result) {
+            page_index = 0;
+            goto flush_done;
+        }
+        device_ctx->panel_ticker.direction = SSD1306_TICKER_OFF;
+    }
+    
+    if (snapshot->plan.strategy == SSD1306_FLUSH_WINDOW) {
+        /* All or nothing: a failure re-marks every span */
+        page_index = 0;
+        window_result = ssd1306_send_flush_window(device_ctx, snapshot);
+        if (window_result < 0) {
+            result = window_result;
+        } else {
+            transferred_bytes = window_result;
+        }
+    } else {
+        for (page_index = 0; page_index < DISPLAY_TOTAL_PAGES; page_index++) {
+            dirty_range = &snapshot->page_ranges[page_index];
+            if (!dirty_range->is_dirty) {
+                continue;
+            }
+            
+            /* Point page mode at the dirty span in one transfer */
+            span_column = device_ctx->panel_column_offset + dirty_range->first_column;
+            ssd1306_command_list_init(&window_commands);
+            ssd1306_add_addressing_mode(device_ctx, &window_commands, SSD1306_ADDRESSING_PAGE);
+            ssd1306_command_list_add(&window_commands, SSD1306_CMD_SET_PAGE_START | page_index);
+            ssd1306_command_list_add(&window_commands, SSD1306_CMD_SET_LOW_COLUMN | (span_column & 0x0F));
+            ssd1306_command_list_add(&window_commands, SSD1306_CMD_SET_HIGH_COLUMN | (span_column >> 4));
+            
+            result = ssd1306_send_command_list(device_ctx, &window_commands);
+            if (result) {
+                break;
+            }
+            device_ctx->panel_addressing_mode = SSD1306_ADDRESSING_PAGE;
+            
+            span_length = dirty_range->last_column - dirty_range->first_column + 1;
+            result = ssd1306_send_i2c_data(device_ctx, 
+                                           &snapshot->page_data[page_index][dirty_range->first_column], 
+                                           span_length);
+            if (result) {
+                break;
+            }
+            transferred_bytes += span_length;
+        }
+    }
+    
+    /* Rotate the visible window only once the newly exposed row is in RAM */
+    if (!result && snapshot->display_start_line != device_ctx->panel_start_line) {
+        result = ssd1306_send_i2c_command(device_ctx, 
+                                          SSD1306_CMD_SET_START_LINE | snapshot->display_start_line);
+        if (!result) {
+            device_ctx->panel_start_line = snapshot->display_start_line;
+        }
+    }
+    
+    /* Re-arm the ticker once its pages hold the new content */
+    if (!result && snapshot->ticker.direction != SSD1306_TICKER_OFF && 
+        device_ctx->panel_ticker.direction == SSD1306_TICKER_OFF) {
+        result = ssd1306_start_panel_ticker(device_ctx, &snapshot->ticker, 
+                                            snapshot->display_start_line);
+    }
+    
+flush_done:
+    trace_ssd1306_flush_end(device_ctx->i2c_client_ptr, snapshot->frame_sequence, 
+                            transferred_bytes, result);
+    
+    if (result) {
+        ssd1306_schedule_panel_recovery(device_ctx);
+    }
+    
+    down_write(&device_ctx->display_lock);
+    if (atomic64_read(&device_ctx->statistics.i2c_transactions) != transactions_before) {
+        ssd1306_record_latency(device_ctx->statistics.flush_latency_histogram, 
+                               ktime_sub(ktime_get(), flush_start_time));
+    }
+    
+    /* Planner versus one window per page, for the same dirty spans */
+    if (dirty_page_count) {
+        device_ctx->statistics.flush_plans[snapshot->plan.strategy]++;
+        device_ctx->statistics.planned_bytes += snapshot->plan.cost;
+        device_ctx->statistics.naive_bytes += snapshot->plan.naive_cost;
+    }
+    
+    if (result) {
+        /* Re-mark unsent spans so the next flush retries them */
+        for (retry_index = page_index; retry_index < DISPLAY_TOTAL_PAGES; retry_index++) {
+            dirty_range = &snapshot->page_ranges[retry_index];
+            if (dirty_range->is_dirty) {
+                ssd1306_mark_page_dirty(device_ctx, retry_index, 
+                                        dirty_range->first_column, dirty_range->last_column);
+            }
+        }
+        
+        /* Writes of this snapshot are still pending, keep their start time */
+        if (snapshot->oldest_write_time) {
+            atomic64_set(&device_ctx->oldest_pending_write, snapshot->oldest_write_time);
+        }
+    } else if (snapshot->frame_sequence > device_ctx->frame_sequence_completed) {
+        /* Everything submitted up to the snapshot is now on the panel */
+        device_ctx->statistics.frames_flushed++;
+        device_ctx->statistics.coalesced_writes += snapshot->frame_sequence - 
+                                                   device_ctx->frame_sequence_completed - 1;
+        device_ctx->frame_sequence_completed = snapshot->frame_sequence;
+        device_ctx->frame_completed_time = ktime_get();
+        
+        if (snapshot->oldest_write_time) {
+            ssd1306_record_latency(device_ctx->statistics.write_latency_histogram, 
+                                   ktime_sub(device_ctx->frame_completed_time, 
+                                             snapshot->oldest_write_time));
+        }
+    }
+    device_ctx->last_flush_result = result;
+    up_write(&device_ctx->display_lock);
+    
+    wake_up_interruptible(&device_ctx->frame_wait_queue);
+    
+    return result;
+}
+
+/**
+ * @brief Wake the panel before bus access
+ * @param device_ctx Pointer to device context
+ * @return 0 on success, negative error code on failure
+ *
+ * Must be called without bus_lock held, the resume callback takes it.
+ */
+static int ssd1306_panel_access_begin(struct ssd1306_device_context *device_ctx)
+{
+    int result;
+    
+    result = pm_runtime_get_sync(&device_ctx->i2c_client_ptr->dev);
+    if (result < 0) {
+        /* The usage count was raised even though the resume failed */
+        pm_runtime_put_noidle(&device_ctx->i2c_client_ptr->dev);
+        return result;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief Drop the panel reference and restart the autosuspend timer
+ * @param device_ctx Pointer to device context
+ */
+static void ssd1306_panel_access_end(struct ssd1306_device_context *device_ctx)
+{
+    pm_runtime_mark_last_busy(&device_ctx->i2c_client_ptr->dev);
+    pm_runtime_put_autosuspend(&device_ctx->i2c_client_ptr->dev);
+}
+
+/**
+ * @brief Keep the panel awake while something is shown without bus traffic
+ * @param device_ctx Pointer to device context
+ * @param holds_reference Owner's flag, true while it holds a reference
+ * @param keep_awake true to take the reference, false to drop it
+ *
+ * A running ticker or an enabled DRM pipe must not be blanked by idle
+ * power-off just because no writes arrive.
+ */
+static void ssd1306_keep_panel_awake(struct ssd1306_device_context *device_ctx, 
+                                     bool *holds_reference, bool keep_awake)
+{
+    if (*holds_reference == keep_awake) {
+        return;
+    }
+    *holds_reference = keep_awake;
+    
+    if (keep_awake) {
+        pm_runtime_get(&device_ctx->i2c_client_ptr->dev);
+    } else {
+        ssd1306_panel_access_end(device_ctx);
+    }
+}
+
+/**
+ * @brief Send dirty framebuffer regions to the display
+ * @param device_ctx Pointer to device context structure
+ * @return 0 on success, negative error code on failure
+ */
+int ssd1306_flush_framebuffer(struct ssd1306_device_context *device_ctx)
+{
+    int result;
+    
+    result = ssd1306_panel_access_begin(device_ctx);
+    if (result) {
+        return result;
+    }
+    
+    mutex_lock(&device_ctx->bus_lock);
+    if (device_ctx->panel_needs_reinit) {
+        /* Recovery replays the whole shadow, content stays dirty until then */
+        ssd1306_schedule_panel_recovery(device_ctx);
+        result = -EIO;
+    } else {
+        result = ssd1306_flush_dirty_pages(device_ctx);
+    }
+    mutex_unlock(&device_ctx->bus_lock);
+    
+    ssd1306_panel_access_end(device_ctx);
+    
+    return result;
+}
+
+/**
+ * @brief Flush worker, runs on the per-panel flush workqueue
+ * @param work Pointer to embedded work structure
+ */
+static void ssd1306_flush_work_handler(struct work_struct *work)
+{
+    struct ssd1306_device_context *device_ctx = 
+        container_of(work, struct ssd1306_device_context, flush_work);
+    
+    ssd1306_flush_framebuffer(device_ctx);
+}
+
+/**
+ * @brief Queue an asynchronous flush of the shadow framebuffer
+ * @param device_ctx Pointer to device context structure
+ * @return Frame sequence number that completes once the content is visible
+ *
+ * Requests made while a flush is pending collapse into it; requests made
+ * while one is running queue exactly one follow-up, which picks up the
+ * latest shadow content. Call after the shadow has been updated.
+ */
+static uint64_t ssd1306_queue_frame(struct ssd1306_device_context *device_ctx)
+{
+    uint64_t frame_sequence = atomic64_inc_return(&device_ctx->frame_sequence_submitted);
+    
+    /* Start the write-to-visible clock unless an older write is still pending */
+    atomic64_cmpxchg(&device_ctx->oldest_pending_write, 0, ktime_get());
+    
+    queue_work(device_ctx->flush_workqueue, &device_ctx->flush_work);
+    return frame_sequence;
+}
+
+/**
+ * @brief Flush after a producer has drawn
+ * @param device_ctx Pointer to device context structure
+ * @return Frame sequence number that completes once the content is visible
+ *
+ * With double buffering the drawing sits in the back buffer, nothing is
+ * queued and the latest submitted frame is returned; SSD1306_IOCTL_FLIP
+ * queues the frame instead.
+ */
+static uint64_t ssd1306_schedule_flush(struct ssd1306_device_context *device_ctx)
+{
+    if (READ_ONCE(device_ctx->is_double_buffered)) {
+        return atomic64_read(&device_ctx->frame_sequence_submitted);
+    }
+    
+    return ssd1306_queue_frame(device_ctx);
+}
+
+/**
+ * @brief Hand the back buffer to the flush engine
+ * @param device_ctx Pointer to device context
+ *
+ * Changed back-buffer spans are diffed into the shadow in one go under
+ * a write-held display_lock, so a flush snapshot sees either none or all
+ * of the frame.
+ */
+static void ssd1306_flip_back_buffer(struct ssd1306_device_context *device_ctx)
+{
+    struct ssd1306_dirty_column_range *back_range;
+    int page_index;
+    
+    for (page_index = 0; page_index < DISPLAY_TOTAL_PAGES; page_index++) {
+        back_range = &device_ctx->back_dirty_ranges[page_index];
+        if (!back_range->is_dirty) {
+            continue;
+        }
+        
+        ssd1306_copy_changed_columns(device_ctx->display_framebuffer[page_index], 
+                                     &device_ctx->page_dirty_ranges[page_index], 
+                                     back_range->first_column, 
+                                     &device_ctx->back_framebuffer[page_index][back_range->first_column], 
+                                     back_range->last_column - back_range->first_column + 1);
+        back_range->is_dirty = false;
+    }
+}
+
+/**
+ * @brief Switch producers between the shadow and a back buffer
+ * @param device_ctx Pointer to device context
+ * @param enable_double_buffer true to start drawing off-screen
+ *
+ * Enabling parks any text scroll offset first so the back buffer maps
+ * RAM pages the same way as the frame on screen. Disabling flips pending
+ * content. Caller holds display_lock for writing and queues a flush
+ * afterwards.
+ */
+static void ssd1306_set_double_buffered(struct ssd1306_device_context *device_ctx, 
+                                        bool enable_double_buffer)
+{
+    if (enable_double_buffer == device_ctx->is_double_buffered) {
+        return;
+    }
+    
+    if (enable_double_buffer) {
+        if (device_ctx->scroll_page_offset) {
+            ssd1306_load_compose_framebuffer(device_ctx);
+            device_ctx->scroll_page_offset = 0;
+            ssd1306_commit_compose_framebuffer(device_ctx);
+        }
+        memcpy(device_ctx->back_framebuffer, device_ctx->display_framebuffer, 
+               sizeof(device_ctx->back_framebuffer));
+        memset(device_ctx->back_dirty_ranges, 0, sizeof(device_ctx->back_dirty_ranges));
+    } else {
+        ssd1306_flip_back_buffer(device_ctx);
+    }
+    
+    WRITE_ONCE(device_ctx->is_double_buffered, enable_double_buffer);
+}
+
+/**
+ * @brief Build the panel initialization sequence
+ * @param device_ctx Pointer to device context
+ * @param init_commands Command list to fill
+ *
+ * Contrast, inversion and on/off come from the device state so the same
+ * sequence restores a panel that lost power.
+ */
+static void ssd1306_build_init_commands(struct ssd1306_device_context *device_ctx, 
+                                        struct ssd1306_command_list *init_commands)
+{
+    ssd1306_command_list_init(init_commands);
+    
+    /* Display OFF during initialization */
+    ssd1306_command_list_add(init_commands, SSD1306_CMD_DISPLAY_OFF);
+    
+    /* Basic initialization sequence - simplified for educational purposes */
+    ssd1306_command_list_add(init_commands, 0xD5); /* Set display clock divide ratio */
+    ssd1306_command_list_add(init_commands, 0x80); /* Default clock setting */
+    
+    ssd1306_command_list_add(init_commands, 0xA8); /* Set multiplex ratio */
+    ssd1306_command_list_add(init_commands, device_ctx->panel_height - 1); /* Panel rows */
+    
+    ssd1306_command_list_add(init_commands, 0xD3); /* Set display offset */
+    ssd1306_command_list_add(init_commands, 0x00); /* No offset */
+    
+    ssd1306_command_list_add(init_commands, SSD1306_CMD_SET_START_LINE); /* Start line 0 */
+    
+    ssd1306_command_list_add(init_commands, SSD1306_CMD_CHARGE_PUMP);
+    ssd1306_command_list_add(init_commands, SSD1306_CHARGE_PUMP_ENABLE);
+    
+    ssd1306_command_list_add(init_commands, SSD1306_CMD_SET_ADDRESSING_MODE);
+    ssd1306_command_list_add(init_commands, SSD1306_ADDRESSING_HORIZONTAL);
+    
+    ssd1306_command_list_add(init_commands, 0xA1); /* Set segment remap */
+    ssd1306_command_list_add(init_commands, 0xC8); /* Set COM scan direction */
+    
+    ssd1306_command_list_add(init_commands, 0xDA); /* Set COM pins configuration */
+    ssd1306_command_list_add(init_commands, device_ctx->panel_com_pins); /* Panel wiring */
+    
+    /* Set contrast */
+    ssd1306_command_list_add(init_commands, SSD1306_CMD_SET_CONTRAST);
+    ssd1306_command_list_add(init_commands, device_ctx->display_brightness_level);
+    
+    ssd1306_command_list_add(init_commands, 0xD9); /* Set pre-charge period */
+    ssd1306_command_list_add(init_commands, 0xF1); /* Pre-charge setting */
+    
+    ssd1306_command_list_add(init_commands, 0xDB); /* Set VCOM detect */
+    ssd1306_command_list_add(init_commands, 0x20); /* VCOM detect setting */
+    
+    ssd1306_command_list_add(init_commands, 0xA4); /* Resume to RAM content display */
+    ssd1306_command_list_add(init_commands, device_ctx->is_display_inverted ? 
+                             SSD1306_CMD_INVERT_DISPLAY : SSD1306_CMD_NORMAL_DISPLAY);
+    ssd1306_command_list_add(init_commands, SSD1306_CMD_SCROLL_STOP);
+    
+    /* Display ON unless userspace switched it off */
+    ssd1306_command_list_add(init_commands, device_ctx->is_display_enabled ? 
+                             SSD1306_CMD_DISPLAY_ON : SSD1306_CMD_DISPLAY_OFF);
+}
+
+/**
+ * @brief Re-initialize the panel and replay the shadow framebuffer
+ * @param device_ctx Pointer to device context
+ * @return 0 on success, negative error code on failure
+ *
+ * Used after the panel may have lost power (system sleep) or state
+ * (transfer errors). Caller holds bus_lock.
+ */
+static int ssd1306_restore_panel_state(struct ssd1306_device_context *device_ctx)
+{
+    struct ssd1306_command_list init_commands;
+    int result;
+    
+    ssd1306_build_init_commands(device_ctx, &init_commands);
+    result = ssd1306_send_command_list(device_ctx, &init_commands);
+    if (result) {
+        return result;
+    }
+    device_ctx->panel_addressing_mode = SSD1306_ADDRESSING_HORIZONTAL;
+    
+    /* Init reset the start line and stopped any ticker */
+    down_write(&device_ctx->display_lock);
+    ssd1306_invalidate_framebuffer(device_ctx);
+    device_ctx->panel_start_line = 0;
+    device_ctx->panel_ticker.direction = SSD1306_TICKER_OFF;
+    up_write(&device_ctx->display_lock);
+    
+    return ssd1306_flush_dirty_pages(device_ctx);
+}
+
+/**
+ * @brief Recovery worker: re-init the panel and replay the shadow framebuffer
+ * @param work Pointer to embedded delayed work structure
+ *
+ * Retries with exponential backoff up to SSD1306_RECOVERY_MAX_ATTEMPTS
+ * times, then waits for the next flush to start a new round.
+ */
+static void ssd1306_recovery_work_handler(struct work_struct *work)
+{
+    struct ssd1306_device_context *device_ctx = 
+        container_of(to_delayed_work(work), struct ssd1306_device_context, recovery_work);
+    int result;
+    
+    mutex_lock(&device_ctx->bus_lock);
+    if (!device_ctx->panel_needs_reinit) {
+        /* Already restored, e.g. by a system resume */
+        device_ctx->recovery_delay_ms = SSD1306_RECOVERY_INITIAL_DELAY_MS;
+        device_ctx->recovery_attempts = 0;
+        mutex_unlock(&device_ctx->bus_lock);
+        return;
+    }
+    mutex_unlock(&device_ctx->bus_lock);
+    
+    /* A suspended panel is restored by the resume callback itself */
+    result = ssd1306_panel_access_begin(device_ctx);
+    if (!result) {
+        mutex_lock(&device_ctx->bus_lock);
+        if (device_ctx->panel_needs_reinit && !ssd1306_restore_panel_state(device_ctx)) {
+            device_ctx->panel_needs_reinit = false;
+        }
+        mutex_unlock(&device_ctx->bus_lock);
+        ssd1306_panel_access_end(device_ctx);
+    }
+    
+    mutex_lock(&device_ctx->bus_lock);
+    if (device_ctx->panel_needs_reinit) {
+        if (++device_ctx->recovery_attempts >= SSD1306_RECOVERY_MAX_ATTEMPTS) {
+            dev_err(&device_ctx->i2c_client_ptr->dev, 
+                    "Panel not responding after %u re-init attempts, retrying on the next update\n", 
+                    device_ctx->recovery_attempts);
+            mutex_unlock(&device_ctx->bus_lock);
+            return;
+        }
+        device_ctx->recovery_delay_ms = min(device_ctx->recovery_delay_ms * 2, 
+                                            (unsigned int)SSD1306_RECOVERY_MAX_DELAY_MS);
+        mod_delayed_work(device_ctx->flush_workqueue, &device_ctx->recovery_work, 
+                         msecs_to_jiffies(device_ctx->recovery_delay_ms));
+        mutex_unlock(&device_ctx->bus_lock);
+        return;
+    }
+    device_ctx->recovery_delay_ms = SSD1306_RECOVERY_INITIAL_DELAY_MS;
+    device_ctx->recovery_attempts = 0;
+    mutex_unlock(&device_ctx->bus_lock);
+    
+    atomic64_inc(&device_ctx->statistics.panel_recoveries);
+    dev_info(&device_ctx->i2c_client_ptr->dev, "Panel re-initialized after bus error\n");
+}
+
+/**
+ * @brief Reset the shadow state to a blank, powered-on panel
+ * @param device_ctx Pointer to device context structure
+ *
+ * No bus traffic; runs in probe before the context is published. The
+ * panel itself is brought up later by ssd1306_bringup_work_handler().
+ */
+static void ssd1306_reset_display_state(struct ssd1306_device_context *device_ctx)
+{
+    /* Power-on defaults */
+    device_ctx->is_display_enabled = true;
+    device_ctx->is_display_inverted = false;
+    device_ctx->display_brightness_level = 128;
+    
+    /* Panel RAM is undefined after power-on, the first flush sends a blank frame */
+    memset(device_ctx->display_framebuffer, 0, sizeof(device_ctx->display_framebuffer));
+    ssd1306_invalidate_framebuffer(device_ctx);
+    device_ctx->scroll_page_offset = 0;
+    device_ctx->pending_scroll_lines = 0;
+    device_ctx->panel_start_line = 0;
+    device_ctx->panel_ticker.direction = SSD1306_TICKER_OFF;
+    ssd1306_reset_text_cells(device_ctx);
+    
+    /* Set initial device state */
+    device_ctx->current_cursor_line = 0;
+    device_ctx->current_cursor_column = 0;
+    
+    /* Nothing has been sent yet, the first panel access runs the full init */
+    device_ctx->panel_needs_reinit = true;
+}
+
+/**
+ * @brief Initialize SSD1306 display hardware
+ * @param device_ctx Pointer to device context structure
+ * @return 0 on success, negative error code on failure
+ *
+ * The first runtime resume sees panel_needs_reinit and sends the init
+ * sequence followed by the whole shadow framebuffer, including anything
+ * written while the panel was still settling. Without CONFIG_PM no
+ * resume callback runs, so the panel is restored here directly.
+ */
+int ssd1306_initialize_display_hardware(struct ssd1306_device_context *device_ctx)
+{
+    int result;
+    
+    dev_dbg(&device_ctx->i2c_client_ptr->dev, "Initializing SSD1306 display hardware\n");
+    
+    /* Wait for display to be ready */
+    msleep(SSD1306_POWER_ON_DELAY_MS);
+    
+    result = ssd1306_panel_access_begin(device_ctx);
+    if (result) {
+        return result;
+    }
+    
+    mutex_lock(&device_ctx->bus_lock);
+    if (!IS_ENABLED(CONFIG_PM) && device_ctx->panel_needs_reinit && 
+        !ssd1306_restore_panel_state(device_ctx)) {
+        device_ctx->panel_needs_reinit = false;
+    }
+    result = device_ctx->panel_needs_reinit ? -EIO : 0;
+    mutex_unlock(&device_ctx->bus_lock);
+    
+    ssd1306_panel_access_end(device_ctx);
+    
+    if (!result) {
+        dev_info(&device_ctx->i2c_client_ptr->dev, 
+                 "SSD1306 display hardware initialized successfully\n");
+    }
+    return result;
+}
+
+/**
+ * @brief Bring-up worker: first panel init, off the probe path
+ * @param work Pointer to embedded work structure
+ *
+ * Queued on the ordered flush workqueue before the character device
+ * exists, so every flush queued by early writers runs after it. A
+ * panel that does not answer is left to the recovery worker.
+ */
+static void ssd1306_bringup_work_handler(struct work_struct *work)
+{
+    struct ssd1306_device_context *device_ctx = 
+        container_of(work, struct ssd1306_device_context, bringup_work);
+    int result;
+    
+    result = ssd1306_initialize_display_hardware(device_ctx);
+    if (result) {
+        dev_err(&device_ctx->i2c_client_ptr->dev, 
+                "Failed to initialize display hardware: %d, retrying in background\n", result);
+        mutex_lock(&device_ctx->bus_lock);
+        ssd1306_schedule_panel_recovery(device_ctx);
+        mutex_unlock(&device_ctx->bus_lock);
+    }
+}
+
+/**
+ * @brief Clear entire display screen
+ * @param device_ctx Pointer to device context structure  
+ * @return 0 on success, negative error code on failure
+ */
+int ssd1306_clear_display_screen(struct ssd1306_device_context *device_ctx)
+{
+    down_write(&device_ctx->display_lock);
+    
+    /* Clear shadow framebuffer, only lit columns become dirty */
+    memset(device_ctx->compose_framebuffer, 0, sizeof(device_ctx->compose_framebuffer));
+    ssd1306_commit_compose_framebuffer(device_ctx);
+    ssd1306_reset_text_cells(device_ctx);
+    
+    /* Reset cursor position */
+    device_ctx->current_cursor_line = 0;
+    device_ctx->current_cursor_column = 0;
+    
+    up_write(&device_ctx->display_lock);
+    
+    return ssd1306_flush_framebuffer(device_ctx);
+}
+
+/**
+ * @brief Set cursor position on display
+ * @param device_ctx Pointer to device context
+ * @param line_number Line number (0 to panel pages - 1)
+ * @param column_number Column number (0 to text columns - 1)
+ * @return 0 on success, negative error code on failure
+ */
+static int ssd1306_set_cursor_position(struct ssd1306_device_context *device_ctx, 
+                                       unsigned int line_number, unsigned int column_number)
+{
+    /* Full-width check, the __u32 UAPI values must not wrap into range */
+    if (line_number >= device_ctx->panel_pages || column_number >= device_ctx->text_columns) {
+        return -EINVAL;
+    }
+    
+    device_ctx->current_cursor_line = line_number;
+    device_ctx->current_cursor_column = column_number;
+    
+    return 0;
+}
+
+/**
+ * @brief Scroll the compose buffer up by one text line
+ * @param device_ctx Pointer to device context
+ *
+ * The shift is mirrored by advancing the display start line at commit,
+ * so only the newly exposed bottom row is transferred.
+ */
+static void ssd1306_scroll_text_up(struct ssd1306_device_context *device_ctx)
+{
+    uint8_t last_line = device_ctx->panel_pages - 1;
+    
+    memmove(device_ctx->compose_framebuffer[0], device_ctx->compose_framebuffer[1], 
+            last_line * DISPLAY_WIDTH_PIXELS);
+    memset(device_ctx->compose_framebuffer[last_line], 0, DISPLAY_WIDTH_PIXELS);
+    
+    device_ctx->pending_scroll_lines = (device_ctx->pending_scroll_lines + 1) % DISPLAY_TOTAL_PAGES;
+}
+
+/**
+ * @brief Font glyph used to draw a character
+ * @param character Any byte, including NUL and control characters
+ * @return Index into font_table_5x8, the blank glyph for non-printable bytes
+ */
+static inline unsigned int ssd1306_glyph_index(char character)
+{
+    unsigned int glyph_index = (unsigned int)(uint8_t)character - FONT_FIRST_CHAR;
+    
+    return glyph_index < FONT_GLYPH_COUNT ? glyph_index : 0;
+}
+
+/**
+ * @brief Cursor line after a newline
+ * @param device_ctx Pointer to device context, provides the panel height
+ * @param line Current cursor line
+ * @return New cursor line
+ *
+ * Lines past the bottom are scrolls still owed, applied once the next
+ * glyph arrives, so every newline scrolls by one like a terminal. More
+ * than a screenful of blank lines is the same as a screenful.
+ */
+static inline unsigned int ssd1306_line_after_newline(const struct ssd1306_device_context *device_ctx, 
+                                                      unsigned int line)
+{
+    return min(line + 1, 2U * device_ctx->panel_pages - 1);
+}
+
+/**
+ * @brief Render single character into the compose buffer
+ * @param device_ctx Pointer to device context
+ * @param character Character to display
+ * @return 0 on success, negative error code on failure
+ */
+static int ssd1306_write_single_character(struct ssd1306_device_context *device_ctx, 
+                                          char character)
+{
+    /* Handle newline character, scrolling waits for the next glyph */
+    if (character == '\n') {
+        device_ctx->current_cursor_line = ssd1306_line_after_newline(device_ctx, 
+                                                                     device_ctx->current_cursor_line);
+        device_ctx->current_cursor_column = 0;
+        return 0;
+    }
+    
+    /* Handle line wrap */
+    if (device_ctx->current_cursor_column >= device_ctx->text_columns) {
+        device_ctx->current_cursor_line++;
+        device_ctx->current_cursor_column = 0;
+    }
+    
+    /* Past the bottom line: scroll once per owed line instead of overwriting the top */
+    while (device_ctx->current_cursor_line >= device_ctx->panel_pages) {
+        ssd1306_scroll_text_up(device_ctx);
+        device_ctx->current_cursor_line--;
+    }
+    
+    /* Non-printable characters render as a blank cell */
+    memcpy(&device_ctx->compose_framebuffer[device_ctx->current_cursor_line]
+                                           [device_ctx->current_cursor_column * FONT_CHAR_WIDTH], 
+           font_table_5x8[ssd1306_glyph_index(character)], FONT_CHAR_WIDTH);
+    
+    device_ctx->current_cursor_column++;
+    
+    return 0;
+}
+
+/**
+ * @brief Render text string into the compose buffer at the cursor
+ * @param device_ctx Pointer to device context structure
+ * @param text_string Null-terminated text string to render
+ */
+static void ssd1306_render_text(struct ssd1306_device_context *device_ctx, 
+                                const char *text_string)
+{
+    while (*text_string) {
+        ssd1306_write_single_character(device_ctx, *text_string++);
+    }
+}
+
+/**
+ * @brief Lay out a message into character cells
+ * @param device_ctx Pointer to device context, provides the panel text grid
+ * @param text_string Null-terminated text starting at the top-left cell
+ * @param cells Cell grid to fill, unused cells become spaces
+ * @param end_line Receives the cursor line after the text
+ * @param end_column Receives the cursor column after the text
+ * @return true if the text fits without scrolling
+ *
+ * Follows the same newline and wrap rules as ssd1306_write_single_character().
+ */
+static bool ssd1306_layout_text_cells(const struct ssd1306_device_context *device_ctx, 
+                                      const char *text_string, 
+                                      char cells[MAX_DISPLAY_LINES][MAX_CHARS_PER_LINE], 
+                                      uint8_t *end_line, uint8_t *end_column)
+{
+    unsigned int line = 0;
+    unsigned int column = 0;
+    char character;
+    
+    memset(cells, ' ', MAX_DISPLAY_LINES * MAX_CHARS_PER_LINE);
+    
+    while ((character = *text_string++)) {
+        if (character == '\n') {
+            line = ssd1306_line_after_newline(device_ctx, line);
+            column = 0;
+            continue;
+        }
+        
+        if (column >= device_ctx->text_columns) {
+            line++;
+            column = 0;
+        }
+        
+        if (line >= device_ctx->panel_pages) {
+            return false;
+        }
+        
+        /* Store what will actually be drawn so blanks compare equal */
+        cells[line][column++] = FONT_FIRST_CHAR + ssd1306_glyph_index(character);
+    }
+    
+    *end_line = line;
+    *end_column = column;
+    return true;
+}
+
+/**
+ * @brief Draw one character cell unless it already shows that character
+ * @param device_ctx Pointer to device context
+ * @param line_index Text line (0 to panel pages - 1)
+ * @param column_index Text column (0 to text columns - 1)
+ * @param character Character to show, non-printable draws a blank
+ *
+ * The glyph goes straight into the shadow framebuffer so only its
+ * columns become dirty. Caller holds display_lock for writing, or for
+ * reading plus the row lock of line_index.
+ */
+static void ssd1306_draw_text_cell(struct ssd1306_device_context *device_ctx, 
+                                   unsigned int line_index, unsigned int column_index, 
+                                   char character)
+{
+    unsigned int glyph_index = ssd1306_glyph_index(character);
+    
+    /* Cells store what is drawn, so every blank compares equal to ' ' */
+    character = FONT_FIRST_CHAR + glyph_index;
+    if (device_ctx->text_line_valid[line_index] && 
+        device_ctx->text_cells[line_index][column_index] == character) {
+        return;
+    }
+    
+    ssd1306_update_framebuffer_columns(device_ctx, line_index, column_index * FONT_CHAR_WIDTH, 
+                                       font_table_5x8[glyph_index], FONT_CHAR_WIDTH);
+    device_ctx->text_cells[line_index][column_index] = character;
+}
+
+/**
+ * @brief Draw the cells that differ from the current character grid
+ * @param device_ctx Pointer to device context
+ * @param cells New cell content
+ *
+ * Caller holds display_lock for writing and has checked
+ * ssd1306_text_cells_valid().
+ */
+static void ssd1306_update_text_cells(struct ssd1306_device_context *device_ctx, 
+                                      char cells[MAX_DISPLAY_LINES][MAX_CHARS_PER_LINE])
+{
+    int line_index;
+    int column_index;
+    
+    for (line_index = 0; line_index < device_ctx->panel_pages; line_index++) {
+        for (column_index = 0; column_index < device_ctx->text_columns; column_index++) {
+            ssd1306_draw_text_cell(device_ctx, line_index, column_index, 
+                                   cells[line_index][column_index]);
+        }
+    }
+}
+
+/**
+ * @brief Draw text at the cursor into the shadow framebuffer only
+ * @param device_ctx Pointer to device context structure
+ * @param text_string Null-terminated text string to draw
+ */
+static void ssd1306_draw_text_to_shadow(struct ssd1306_device_context *device_ctx, 
+                                        const char *text_string)
+{
+    down_write(&device_ctx->display_lock);
+    
+    /* Draw on top of current content */
+    ssd1306_load_compose_framebuffer(device_ctx);
+    ssd1306_render_text(device_ctx, text_string);
+    ssd1306_commit_compose_framebuffer(device_ctx);
+    ssd1306_invalidate_text_cells(device_ctx);
+    
+    up_write(&device_ctx->display_lock);
+}
+
+/**
+ * @brief Write text string to display
+ * @param device_ctx Pointer to device context structure
+ * @param text_string Null-terminated text string to display
+ * @return 0 on success, negative error code on failure
+ */
+int ssd1306_write_text_to_display(struct ssd1306_device_context *device_ctx, 
+                                  const char *text_string)
+{
+    ssd1306_draw_text_to_shadow(device_ctx, text_string);
+    
+    return ssd1306_flush_framebuffer(device_ctx);
+}
+
+/**
+ * @brief Set display brightness level
+ * @param device_ctx Pointer to device context structure
+ * @param brightness_level Brightness level (0-255)
+ * @return 0 on success, negative error code on failure
+ */
+int ssd1306_set_display_brightness(struct ssd1306_device_context *device_ctx, 
+                                   uint8_t brightness_level)
+{
+    struct ssd1306_command_list contrast_commands;
+    int result;
+    
+    ssd1306_command_list_init(&contrast_commands);
+    ssd1306_command_list_add(&contrast_commands, SSD1306_CMD_SET_CONTRAST);
+    ssd1306_command_list_add(&contrast_commands, brightness_level);
+    
+    result = ssd1306_panel_access_begin(device_ctx);
+    if (result) {
+        return result;
+    }
+    
+    mutex_lock(&device_ctx->bus_lock);
+    if (device_ctx->panel_needs_reinit) {
+        /* Applied by the pending re-init */
+        device_ctx->display_brightness_level = brightness_level;
+    } else {
+        result = ssd1306_send_command_list(device_ctx, &contrast_commands);
+        if (!result) {
+            device_ctx->display_brightness_level = brightness_level;
+        } else {
+            ssd1306_schedule_panel_recovery(device_ctx);
+        }
+    }
+    mutex_unlock(&device_ctx->bus_lock);
+    
+    ssd1306_panel_access_end(device_ctx);
+    
+    return result;
+}
+
+/**
+ * @brief Set normal or inverted display mode
+ * @param device_ctx Pointer to device context structure
+ * @param invert_display true to light pixels stored as 0
+ * @return 0 on success, negative error code on failure
+ */
+int ssd1306_set_display_inverted(struct ssd1306_device_context *device_ctx, 
+                                 bool invert_display)
+{
+    int result;
+    
+    result = ssd1306_panel_access_begin(device_ctx);
+    if (result) {
+        return result;
+    }
+    
+    mutex_lock(&device_ctx->bus_lock);
+    if (device_ctx->panel_needs_reinit) {
+        /* Applied by the pending re-init */
+        device_ctx->is_display_inverted = invert_display;
+    } else {
+        result = ssd1306_send_i2c_command(device_ctx, invert_display ? SSD1306_CMD_INVERT_DISPLAY 
+                                                                     : SSD1306_CMD_NORMAL_DISPLAY);
+        if (!result) {
+            device_ctx->is_display_inverted = invert_display;
+        } else {
+            ssd1306_schedule_panel_recovery(device_ctx);
+        }
+    }
+    mutex_unlock(&device_ctx->bus_lock);
+    
+    ssd1306_panel_access_end(device_ctx);
+    
+    return result;
+}
+
+/**
+ * @brief Switch the panel on or off, RAM content is kept
+ * @param device_ctx Pointer to device context structure
+ * @param enable_display true for display ON
+ * @return 0 on success, negative error code on failure
+ */
+int ssd1306_set_display_power(struct ssd1306_device_context *device_ctx, 
+                              bool enable_display)
+{
+    int result;
+    
+    result = ssd1306_panel_access_begin(device_ctx);
+    if (result) {
+        return result;
+    }
+    
+    mutex_lock(&device_ctx->bus_lock);
+    if (device_ctx->panel_needs_reinit) {
+        /* Applied by the pending re-init */
+        device_ctx->is_display_enabled = enable_display;
+    } else {
+        result = ssd1306_send_i2c_command(device_ctx, enable_display ? SSD1306_CMD_DISPLAY_ON 
+                                                                     : SSD1306_CMD_DISPLAY_OFF);
+        if (!result) {
+            device_ctx->is_display_enabled = enable_display;
+        } else {
+            ssd1306_schedule_panel_recovery(device_ctx);
+        }
+    }
+    mutex_unlock(&device_ctx->bus_lock);
+    
+    ssd1306_panel_access_end(device_ctx);
+    
+    return result;
+}
+
+/* Character Device File Operations Implementation */
+
+/**
+ * @brief Start a file operation on a panel that may have been removed
+ * @param device_ctx Pointer to device context
+ * @return 0 with removal_lock held shared, -ENODEV once the panel is gone
+ *
+ * Remove takes removal_lock exclusively before tearing down the bus
+ * buffer and the flush workqueue, so an operation that got in finishes
+ * against a live panel and every later one fails cleanly.
+ */
+static int ssd1306_file_operation_begin(struct ssd1306_device_context *device_ctx)
+{
+    down_read(&device_ctx->removal_lock);
+    if (device_ctx->is_removed) {
+        up_read(&device_ctx->removal_lock);
+        return -ENODEV;
+    }
+    return 0;
+}
+
+/**
+ * @brief Finish a file operation started with ssd1306_file_operation_begin()
+ * @param device_ctx Pointer to device context
+ */
+static void ssd1306_file_operation_end(struct ssd1306_device_context *device_ctx)
+{
+    up_read(&device_ctx->removal_lock);
+}
+
+/**
+ * @brief Character device open operation
+ * @param inode_ptr Pointer to inode structure
+ * @param file_ptr Pointer to file structure
+ * @return 0 on success, negative error code on failure
+ */
+static int ssd1306_char_device_open(struct inode *inode_ptr, struct file *file_ptr)
+{
+    struct ssd1306_device_context *device_ctx = container_of(inode_ptr->i_cdev, 
+                                                             struct ssd1306_device_context, 
+                                                             char_device_cdev);
+    struct ssd1306_file_context *file_ctx;
+    int result;
+    
+    /* The open may have raced with remove after finding the cdev */
+    result = ssd1306_file_operation_begin(device_ctx);
+    if (result) {
+        return result;
+    }
+    
+    file_ctx = kzalloc(sizeof(*file_ctx), GFP_KERNEL);
+    if (!file_ctx) {
+        ssd1306_file_operation_end(device_ctx);
+        return -ENOMEM;
+    }
+    
+    file_ctx->device_ctx = device_ctx;
+    file_ptr->private_data = file_ctx;
+    dev_dbg(&device_ctx->i2c_client_ptr->dev, 
+            "SSD1306 character device opened\n");
+    ssd1306_file_operation_end(device_ctx);
+    return 0;
+}
+
+/**
+ * @brief Character device release operation
+ * @param inode_ptr Pointer to inode structure
+ * @param file_ptr Pointer to file structure
+ * @return 0 on success, negative error code on failure
+ */
+static int ssd1306_char_device_release(struct inode *inode_ptr, struct file *file_ptr)
+{
+    struct ssd1306_file_context *file_ctx = file_ptr->private_data;
+    
+    /* The context stays valid until the cdev drops its device reference */
+    dev_dbg(&file_ctx->device_ctx->char_device, 
+            "SSD1306 character device closed\n");
+    kfree(file_ctx);
+    return 0;
+}
+
+/**
+ * @brief Write text into character cells starting at the file offset
+ * @param file_ptr Pointer to file structure
+ * @param message_buffer Null-terminated text copied from userspace
+ * @param message_length Length of message_buffer
+ * @param file_position Cell index (line * MAX_CHARS_PER_LINE + column)
+ * @return Number of bytes consumed or negative error code
+ *
+ * Cells outside the written range are left untouched and nothing is
+ * cleared. A newline moves to the start of the next line; text stops at
+ * the end of the grid. Any other control character or NUL occupies its
+ * cell and is drawn as a blank. Lines keep the 21-cell stride on narrower
+ * panels, characters past the visible columns are consumed but not drawn.
+ */
+static ssize_t ssd1306_write_text_cells_at(struct file *file_ptr, const char *message_buffer, 
+                                           size_t message_length, loff_t *file_position)
+{
+    struct ssd1306_file_context *file_ctx = file_ptr->private_data;
+    struct ssd1306_device_context *device_ctx = file_ctx->device_ctx;
+    unsigned int cell_limit = device_ctx->panel_pages * MAX_CHARS_PER_LINE;
+    unsigned int locked_line = UINT_MAX;
+    unsigned int cell_index;
+    size_t consumed_count = 0;
+    
+    if (*file_position < 0 || *file_position >= cell_limit) {
+        return -ENOSPC;
+    }
+    cell_index = *file_position;
+    
+    /* Only the rows being written are locked, other lines update in parallel */
+    down_read(&device_ctx->display_lock);
+    
+    while (consumed_count < message_length && cell_index < cell_limit) {
+        char character = message_buffer[consumed_count++];
+        unsigned int line_index = cell_index / MAX_CHARS_PER_LINE;
+        
+        if (character == '\n') {
+            cell_index = roundup(cell_index + 1, MAX_CHARS_PER_LINE);
+            continue;
+        }
+        
+        if (cell_index % MAX_CHARS_PER_LINE < device_ctx->text_columns) {
+            if (line_index != locked_line) {
+                if (locked_line != UINT_MAX) {
+                    ssd1306_unlock_page_row(device_ctx, locked_line);
+                }
+                ssd1306_lock_page_row(device_ctx, line_index);
+                locked_line = line_index;
+            }
+            /* Control characters and NUL are not skipped, they blank their cell */
+            ssd1306_draw_text_cell(device_ctx, line_index, cell_index % MAX_CHARS_PER_LINE, 
+                                   FONT_FIRST_CHAR + ssd1306_glyph_index(character));
+        }
+        cell_index++;
+    }
+    
+    if (locked_line != UINT_MAX) {
+        ssd1306_unlock_page_row(device_ctx, locked_line);
+    }
+    up_read(&device_ctx->display_lock);
+    
+    *file_position = cell_index;
+    file_ctx->submitted_frame_sequence = ssd1306_schedule_flush(device_ctx);
+    
+    return consumed_count;
+}
+
+/**
+ * @brief Apply one decoded run of a binary frame to the shadow framebuffer
+ * @param device_ctx Pointer to device context
+ * @param frame_offset Byte offset of the run in the page-format frame
+ * @param run_length Number of decoded bytes
+ * @param literal_bytes Literal bytes, NULL for a repeat run
+ * @param repeat_value Byte repeated when literal_bytes is NULL
+ * @param xor_delta true to XOR the run into the current frame
+ *
+ * Runs are split at page row ends; only columns that change are marked
+ * dirty. Caller holds display_lock for writing.
+ */
+static void ssd1306_apply_frame_run(struct ssd1306_device_context *device_ctx, 
+                                    unsigned int frame_offset, unsigned int run_length, 
+                                    const uint8_t *literal_bytes, uint8_t repeat_value, 
+                                    bool xor_delta)
+{
+    uint8_t page_columns[DISPLAY_WIDTH_PIXELS];
+    unsigned int page_index, first_column, span_length, column_index;
+    const uint8_t *current_page;
+    
+    while (run_length) {
+        page_index = frame_offset / device_ctx->panel_width;
+        first_column = frame_offset % device_ctx->panel_width;
+        span_length = min(run_length, device_ctx->panel_width - first_column);
+        current_page = ssd1306_render_page(device_ctx, page_index);
+        
+        for (column_index = 0; column_index < span_length; column_index++) {
+            uint8_t value = literal_bytes ? literal_bytes[column_index] : repeat_value;
+            
+            if (xor_delta) {
+                value ^= current_page[first_column + column_index];
+            }
+            page_columns[column_index] = value;
+        }
+        
+        ssd1306_update_framebuffer_columns(device_ctx, page_index, first_column, 
+                                           page_columns, span_length);
+        
+        if (literal_bytes) {
+            literal_bytes += span_length;
+        }
+        frame_offset += span_length;
+        run_length -= span_length;
+    }
+}
+
+/**
+ * @brief Decode a run-length frame stream, optionally applying it
+ * @param device_ctx Pointer to device context
+ * @param frame_stream Encoded frame (see SSD1306_WRITE_MODE_FRAME_RLE)
+ * @param stream_length Length of frame_stream
+ * @param xor_delta true for SSD1306_WRITE_MODE_FRAME_DELTA
+ * @param apply false to only validate, true to draw (display_lock held for writing)
+ * @return 0 if the stream decodes to exactly one frame, -EINVAL otherwise
+ *
+ * Zero runs of a delta change nothing and are skipped without touching
+ * the shadow, so dirty ranges come straight from the delta.
+ */
+static int ssd1306_decode_frame_stream(struct ssd1306_device_context *device_ctx, 
+                                       const uint8_t *frame_stream, size_t stream_length, 
+                                       bool xor_delta, bool apply)
+{
+    unsigned int frame_size = device_ctx->panel_width * device_ctx->panel_pages;
+    unsigned int frame_offset = 0;
+    size_t stream_position = 0;
+    
+    while (stream_position < stream_length) {
+        uint8_t run_header = frame_stream[stream_position++];
+        unsigned int run_length = (run_header & SSD1306_FRAME_RUN_LENGTH) + 1;
+        const uint8_t *literal_bytes = NULL;
+        uint8_t repeat_value = 0;
+        
+        if (run_header & SSD1306_FRAME_RUN_REPEAT) {
+            if (stream_position >= stream_length) {
+                return -EINVAL;
+            }
+            repeat_value = frame_stream[stream_position++];
+        } else {
+            if (stream_length - stream_position < run_length) {
+                return -EINVAL;
+            }
+            literal_bytes = &frame_stream[stream_position];
+            stream_position += run_length;
+        }
+        
+        if (run_length > frame_size - frame_offset) {
+            return -EINVAL;
+        }
+        
+        if (apply && (literal_bytes || repeat_value || !xor_delta)) {
+            ssd1306_apply_frame_run(device_ctx, frame_offset, run_length, 
+                                    literal_bytes, repeat_value, xor_delta);
+        }
+        frame_offset += run_length;
+    }
+    
+    return frame_offset == frame_size ? 0 : -EINVAL;
+}
+
+/**
+ * @brief Write one RLE or XOR-delta encoded frame
+ * @param file_ptr Pointer to file structure
+ * @param user_buffer Encoded frame in userspace
+ * @param write_count Length of the encoded frame
+ * @return write_count on success or negative error code
+ */
+static ssize_t ssd1306_write_encoded_frame(struct file *file_ptr, const char __user *user_buffer, 
+                                           size_t write_count)
+{
+    struct ssd1306_file_context *file_ctx = file_ptr->private_data;
+    struct ssd1306_device_context *device_ctx = file_ctx->device_ctx;
+    bool xor_delta = file_ctx->write_mode == SSD1306_WRITE_MODE_FRAME_DELTA;
+    uint8_t *frame_stream;
+    int result;
+    
+    if (!write_count || write_count > SSD1306_MAX_FRAME_STREAM) {
+        return -EINVAL;
+    }
+    
+    frame_stream = memdup_user(user_buffer, write_count);
+    if (IS_ERR(frame_stream)) {
+        return PTR_ERR(frame_stream);
+    }
+    
+    /* Validate the whole stream first so a bad frame draws nothing */
+    result = ssd1306_decode_frame_stream(device_ctx, frame_stream, write_count, xor_delta, false);
+    if (!result) {
+        down_write(&device_ctx->display_lock);
+        ssd1306_decode_frame_stream(device_ctx, frame_stream, write_count, xor_delta, true);
+        ssd1306_invalidate_text_cells(device_ctx);
+        up_write(&device_ctx->display_lock);
+        
+        file_ctx->submitted_frame_sequence = ssd1306_schedule_flush(device_ctx);
+    }
+    
+    kfree(frame_stream);
+    return result ? result : write_count;
+}
+
+/**
+ * @brief Write to the panel in the file's write mode
+ * @param file_ptr Pointer to file structure
+ * @param user_buffer User space buffer containing data to write
+ * @param write_count Number of bytes to write
+ * @param file_position File position pointer
+ * @return Number of bytes written or negative error code
+ */
+static ssize_t ssd1306_dispatch_write(struct file *file_ptr, const char __user *user_buffer, 
+                                      size_t write_count, loff_t *file_position)
+{
+    struct ssd1306_file_context *file_ctx = file_ptr->private_data;
+    struct ssd1306_device_context *device_ctx = file_ctx->device_ctx;
+    char message_buffer[MAX_MESSAGE_BUFFER_SIZE];
+    char message_cells[MAX_DISPLAY_LINES][MAX_CHARS_PER_LINE];
+    uint8_t end_line;
+    uint8_t end_column;
+    size_t safe_write_count = min(write_count, (size_t)(MAX_MESSAGE_BUFFER_SIZE - 1));
+    
+    if (file_ctx->write_mode == SSD1306_WRITE_MODE_FRAME_RLE || 
+        file_ctx->write_mode == SSD1306_WRITE_MODE_FRAME_DELTA) {
+        return ssd1306_write_encoded_frame(file_ptr, user_buffer, write_count);
+    }
+    
+    if (copy_from_user(message_buffer, user_buffer, safe_write_count)) {
+        return -EFAULT;
+    }
+    
+    message_buffer[safe_write_count] = '\0';
+    
+    if (file_ctx->write_mode == SSD1306_WRITE_MODE_CELLS) {
+        return ssd1306_write_text_cells_at(file_ptr, message_buffer, 
+                                           safe_write_count, file_position);
+    }
+    
+    dev_dbg(&device_ctx->i2c_client_ptr->dev, 
+            "Writing text to display: %s\n", message_buffer);
+    
+    down_write(&device_ctx->display_lock);
+    
+    if (file_ptr->f_flags & O_APPEND) {
+        size_t stored_length = strlen(device_ctx->message_display_buffer);
+        size_t keep_length = min(stored_length, 
+                                 (size_t)(MAX_MESSAGE_BUFFER_SIZE - 1) - safe_write_count);
+        
+        /* Log-tail mode: continue at the cursor, scrolling as lines fill */
+        ssd1306_load_compose_framebuffer(device_ctx);
+        ssd1306_render_text(device_ctx, message_buffer);
+        ssd1306_commit_compose_framebuffer(device_ctx);
+        ssd1306_invalidate_text_cells(device_ctx);
+        
+        /* Keep the most recent text in the device buffer */
+        memmove(device_ctx->message_display_buffer, 
+                device_ctx->message_display_buffer + stored_length - keep_length, keep_length);
+        memcpy(device_ctx->message_display_buffer + keep_length, message_buffer, safe_write_count + 1);
+    } else if (ssd1306_layout_text_cells(device_ctx, message_buffer, message_cells, 
+                                         &end_line, &end_column)) {
+        /* Pixels drawn by other interfaces are unknown to the grid, start clean */
+        if (!ssd1306_text_cells_valid(device_ctx)) {
+            memset(device_ctx->compose_framebuffer, 0, sizeof(device_ctx->compose_framebuffer));
+            ssd1306_commit_compose_framebuffer(device_ctx);
+            ssd1306_reset_text_cells(device_ctx);
+        }
+        
+        /* Redraw only the character cells that changed */
+        ssd1306_update_text_cells(device_ctx, message_cells);
+        device_ctx->current_cursor_line = end_line;
+        device_ctx->current_cursor_column = end_column;
+        
+        /* Save message to device buffer */
+        strncpy(device_ctx->message_display_buffer, message_buffer, MAX_MESSAGE_BUFFER_SIZE - 1);
+        device_ctx->message_display_buffer[MAX_MESSAGE_BUFFER_SIZE - 1] = '\0';
+    } else {
+        /* Too long for one screen: render with scrolling, then send only what changed */
+        memset(device_ctx->compose_framebuffer, 0, sizeof(device_ctx->compose_framebuffer));
+        ssd1306_set_cursor_position(device_ctx, 0, 0);
+        ssd1306_render_text(device_ctx, message_buffer);
+        ssd1306_commit_compose_framebuffer(device_ctx);
+        ssd1306_invalidate_text_cells(device_ctx);
+        
+        /* Save message to device buffer */
+        strncpy(device_ctx->message_display_buffer, message_buffer, MAX_MESSAGE_BUFFER_SIZE - 1);
+        device_ctx->message_display_buffer[MAX_MESSAGE_BUFFER_SIZE - 1] = '\0';
+    }
+    
+    up_write(&device_ctx->display_lock);
+    
+    /* Bus traffic happens on the flush worker, writer returns right away */
+    file_ctx->submitted_frame_sequence = ssd1306_schedule_flush(device_ctx);
+    
+    return safe_write_count;
+}
+
+/**
+ * @brief Character device write operation
+ * @param file_ptr Pointer to file structure
+ * @param user_buffer User space buffer containing data to write
+ * @param write_count Number of bytes to write
+ * @param file_position File position pointer
+ * @return Number of bytes written or negative error code
+ */
+static ssize_t ssd1306_char_device_write(struct file *file_ptr, const char __user *user_buffer, 
+                                         size_t write_count, loff_t *file_position)
+{
+    struct ssd1306_file_context *file_ctx = file_ptr->private_data;
+    ssize_t result;
+    
+    result = ssd1306_file_operation_begin(file_ctx->device_ctx);
+    if (result) {
+        return result;
+    }
+    
+    result = ssd1306_dispatch_write(file_ptr, user_buffer, write_count, file_position);
+    ssd1306_file_operation_end(file_ctx->device_ctx);
+    return result;
+}
+
+/**
+ * @brief Character device read operation
+ * @param file_ptr Pointer to file structure
+ * @param user_buffer User space buffer to read data into
+ * @param read_count Number of bytes to read
+ * @param file_position File position pointer
+ * @return Number of bytes read or negative error code
+ */
+static ssize_t ssd1306_char_device_read(struct file *file_ptr, char __user *user_buffer, 
+                                        size_t read_count, loff_t *file_position)
+{
+    struct ssd1306_file_context *file_ctx = file_ptr->private_data;
+    struct ssd1306_device_context *device_ctx = file_ctx->device_ctx;
+    char message_buffer[MAX_MESSAGE_BUFFER_SIZE];
+    size_t buffer_length;
+    int line_index;
+    int result;
+    
+    result = ssd1306_file_operation_begin(device_ctx);
+    if (result) {
+        return result;
+    }
+    
+    /* Snapshot message so a concurrent write cannot tear it */
+    down_read(&device_ctx->display_lock);
+    if (file_ctx->write_mode == SSD1306_WRITE_MODE_CELLS) {
+        /* Cell offsets read back the character grid, each line under its row lock */
+        buffer_length = device_ctx->panel_pages * MAX_CHARS_PER_LINE;
+        for (line_index = 0; line_index < device_ctx->panel_pages; line_index++) {
+            ssd1306_lock_page_row(device_ctx, line_index);
+            memcpy(&message_buffer[line_index * MAX_CHARS_PER_LINE], 
+                   device_ctx->text_cells[line_index], MAX_CHARS_PER_LINE);
+            ssd1306_unlock_page_row(device_ctx, line_index);
+        }
+    } else {
+        strscpy(message_buffer, device_ctx->message_display_buffer, sizeof(message_buffer));
+        buffer_length = strlen(message_buffer);
+    }
+    up_read(&device_ctx->display_lock);
+    ssd1306_file_operation_end(device_ctx);
+    
+    if (*file_position >= buffer_length) {
+        return 0; /* End of file */
+    }
+    
+    if (read_count > buffer_length - *file_position) {
+        read_count = buffer_length - *file_position;
+    }
+    
+    if (copy_to_user(user_buffer, message_buffer + *file_position, read_count)) {
+        return -EFAULT;
+    }
+    
+    *file_position += read_count;
+    return read_count;
+}
+
+/**
+ * @brief Character device llseek operation
+ * @param file_ptr Pointer to file structure
+ * @param offset Seek offset
+ * @param whence SEEK_SET, SEEK_CUR or SEEK_END
+ * @return New file position or negative error code
+ *
+ * In cell mode the file spans the character grid, otherwise the stored
+ * message buffer.
+ */
+static loff_t ssd1306_char_device_llseek(struct file *file_ptr, loff_t offset, int whence)
+{
+    struct ssd1306_file_context *file_ctx = file_ptr->private_data;
+    struct ssd1306_device_context *device_ctx = file_ctx->device_ctx;
+    
+    if (file_ctx->write_mode == SSD1306_WRITE_MODE_CELLS) {
+        return fixed_size_llseek(file_ptr, offset, whence, 
+                                 device_ctx->panel_pages * MAX_CHARS_PER_LINE);
+    }
+    
+    return fixed_size_llseek(file_ptr, offset, whence, MAX_MESSAGE_BUFFER_SIZE);
+}
+
+/**
+ * @brief Count a new mapping of the shared framebuffer (fork, split)
+ * @param vma Userspace mapping
+ */
+static void ssd1306_mmap_vm_open(struct vm_area_struct *vma)
+{
+    struct ssd1306_device_context *device_ctx = vma->vm_private_data;
+    
+    down_write(&device_ctx->display_lock);
+    device_ctx->mmap_users++;
+    up_write(&device_ctx->display_lock);
+}
+
+/**
+ * @brief Drop a mapping of the shared framebuffer
+ * @param vma Userspace mapping
+ */
+static void ssd1306_mmap_vm_close(struct vm_area_struct *vma)
+{
+    struct ssd1306_device_context *device_ctx = vma->vm_private_data;
+    
+    down_write(&device_ctx->display_lock);
+    device_ctx->mmap_users--;
+    up_write(&device_ctx->display_lock);
+}
+
+static const struct vm_operations_struct ssd1306_mmap_vm_operations = {
+    .open = ssd1306_mmap_vm_open,
+    .close = ssd1306_mmap_vm_close,
+};
+
+/**
+ * @brief Character device mmap operation
+ * @param file_ptr Pointer to file structure
+ * @param vma Userspace mapping to populate
+ * @return 0 on success, negative error code on failure
+ *
+ * Maps the page-format framebuffer (SSD1306_FB_SIZE bytes, one 128-byte
+ * row per page). All mappings share one buffer; the first one is seeded
+ * from the panel so partial drawing starts from what is visible, later
+ * ones keep what the others have drawn. Smaller panels use the top-left
+ * corner.
+ */
+static int ssd1306_char_device_mmap(struct file *file_ptr, struct vm_area_struct *vma)
+{
+    struct ssd1306_file_context *file_ctx = file_ptr->private_data;
+    struct ssd1306_device_context *device_ctx = file_ctx->device_ctx;
+    unsigned long mapping_size = vma->vm_end - vma->vm_start;
+    int result;
+    
+    if (vma->vm_pgoff || mapping_size > PAGE_ALIGN(SSD1306_FB_SIZE)) {
+        return -EINVAL;
+    }
+    
+    result = ssd1306_file_operation_begin(device_ctx);
+    if (result) {
+        return result;
+    }
+    
+    down_write(&device_ctx->display_lock);
+    if (!device_ctx->mmap_users) {
+        ssd1306_load_compose_framebuffer(device_ctx);
+        memcpy(device_ctx->mmap_framebuffer, device_ctx->compose_framebuffer, SSD1306_FB_SIZE);
+    }
+    device_ctx->mmap_users++;
+    up_write(&device_ctx->display_lock);
+    
+    /* The buffer is freed with the context, after the last mapping's file is released */
+    vma->vm_private_data = device_ctx;
+    result = remap_vmalloc_range(vma, device_ctx->mmap_framebuffer, 0);
+    if (result) {
+        ssd1306_mmap_vm_close(vma);
+    } else {
+        vma->vm_ops = &ssd1306_mmap_vm_operations;
+    }
+    ssd1306_file_operation_end(device_ctx);
+    return result;
+}
+
+/**
+ * @brief Copy one rectangle of the mapped framebuffer into the shadow
+ * @param device_ctx Pointer to device context
+ * @param flush_rect Rectangle in pixel coordinates, already validated
+ *
+ * Caller holds display_lock for reading; each page row is locked while
+ * it is copied.
+ */
+static void ssd1306_commit_mmap_rect(struct ssd1306_device_context *device_ctx, 
+                                     const struct ssd1306_rect *flush_rect)
+{
+    unsigned int first_page = flush_rect->y / 8;
+    unsigned int last_page = (flush_rect->y + flush_rect->height - 1) / 8;
+    unsigned int page_index;
+    
+    for (page_index = first_page; page_index <= last_page; page_index++) {
+        ssd1306_lock_page_row(device_ctx, page_index);
+        ssd1306_update_framebuffer_columns(device_ctx, page_index, flush_rect->x, 
+                                           &device_ctx->mmap_framebuffer[page_index * SSD1306_FB_WIDTH + 
+                                                                         flush_rect->x], 
+                                           flush_rect->width);
+        device_ctx->text_line_valid[page_index] = false;
+        ssd1306_unlock_page_row(device_ctx, page_index);
+    }
+}
+
+/**
+ * @brief Handle SSD1306_IOCTL_FLUSH
+ * @param device_ctx Pointer to device context
+ * @param user_argument Userspace struct ssd1306_flush_request
+ * @return 0 on success, negative error code on failure
+ */
+static int ssd1306_ioctl_flush(struct ssd1306_file_context *file_ctx, 
+                               void __user *user_argument)
+{
+    struct ssd1306_device_context *device_ctx = file_ctx->device_ctx;
+    struct ssd1306_rect flush_rects[SSD1306_MAX_FLUSH_RECTS];
+    struct ssd1306_rect full_frame = {0, 0, device_ctx->panel_width, device_ctx->panel_height};
+    struct ssd1306_flush_request flush_request;
+    unsigned int rect_index;
+    
+    if (copy_from_user(&flush_request, user_argument, sizeof(flush_request))) {
+        return -EFAULT;
+    }
+    
+    if (flush_request.reserved || flush_request.rect_count > SSD1306_MAX_FLUSH_RECTS) {
+        return -EINVAL;
+    }
+    
+    if (flush_request.rect_count == 0) {
+        flush_rects[0] = full_frame;
+    } else if (copy_from_user(flush_rects, u64_to_user_ptr(flush_request.rects_ptr), 
+                              flush_request.rect_count * sizeof(flush_rects[0]))) {
+        return -EFAULT;
+    }
+    
+    /* Reject empty or out-of-bounds rectangles before touching the shadow */
+    for (rect_index = 0; rect_index < max(flush_request.rect_count, 1U); rect_index++) {
+        const struct ssd1306_rect *flush_rect = &flush_rects[rect_index];
+        
+        if (!flush_rect->width || !flush_rect->height || 
+            flush_rect->x + flush_rect->width > device_ctx->panel_width || 
+            flush_rect->y + flush_rect->height > device_ctx->panel_height) {
+            return -EINVAL;
+        }
+    }
+    
+    down_read(&device_ctx->display_lock);
+    
+    for (rect_index = 0; rect_index < max(flush_request.rect_count, 1U); rect_index++) {
+        ssd1306_commit_mmap_rect(device_ctx, &flush_rects[rect_index]);
+    }
+    
+    up_read(&device_ctx->display_lock);
+    
+    file_ctx->submitted_frame_sequence = ssd1306_schedule_flush(device_ctx);
+    return 0;
+}
+
+/**
+ * @brief Handle SSD1306_IOCTL_GET_FRAME_INFO
+ * @param file_ctx Pointer to per-open file context
+ * @param user_argument Userspace struct ssd1306_frame_info
+ * @return 0 on success, negative error code on failure
+ */
+static int ssd1306_ioctl_get_frame_info(struct ssd1306_file_context *file_ctx, 
+                                        void __user *user_argument)
+{
+    struct ssd1306_device_context *device_ctx = file_ctx->device_ctx;
+    struct ssd1306_frame_info frame_info = {0};
+    
+    down_read(&device_ctx->display_lock);
+    frame_info.submitted_sequence = file_ctx->submitted_frame_sequence;
+    frame_info.completed_sequence = device_ctx->frame_sequence_completed;
+    frame_info.completed_timestamp_ns = ktime_to_ns(device_ctx->frame_completed_time);
+    frame_info.last_flush_error = device_ctx->last_flush_result;
+    up_read(&device_ctx->display_lock);
+    
+    if (copy_to_user(user_argument, &frame_info, sizeof(frame_info))) {
+        return -EFAULT;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief SSD1306_IOCTL_SET_TICKER handler
+ * @param file_ctx Pointer to per-open file context
+ * @param user_argument Userspace struct ssd1306_ticker
+ * @return 0 on success, negative error code on failure
+ *
+ * The scroll engine works on a fixed RAM page range, so text scrolling
+ * offset is folded back to zero before the ticker is started.
+ */
+static int ssd1306_ioctl_set_ticker(struct ssd1306_file_context *file_ctx, 
+                                    void __user *user_argument)
+{
+    struct ssd1306_device_context *device_ctx = file_ctx->device_ctx;
+    struct ssd1306_ticker ticker;
+    
+    if (copy_from_user(&ticker, user_argument, sizeof(ticker))) {
+        return -EFAULT;
+    }
+    
+    if (ticker.direction == SSD1306_TICKER_OFF) {
+        memset(&ticker, 0, sizeof(ticker));
+    } else if (ticker.direction > SSD1306_TICKER_LEFT || 
+               ticker.first_page > ticker.last_page || 
+               ticker.last_page >= device_ctx->panel_pages || 
+               ssd1306_ticker_interval_code(ticker.frame_interval) < 0) {
+        return -EINVAL;
+    }
+    
+    down_write(&device_ctx->display_lock);
+    if (ticker.direction != SSD1306_TICKER_OFF && device_ctx->scroll_page_offset) {
+        ssd1306_load_compose_framebuffer(device_ctx);
+        device_ctx->scroll_page_offset = 0;
+        ssd1306_commit_compose_framebuffer(device_ctx);
+    }
+    device_ctx->ticker_config = ticker;
+    ssd1306_keep_panel_awake(device_ctx, &device_ctx->ticker_holds_panel, 
+                             ticker.direction != SSD1306_TICKER_OFF);
+    up_write(&device_ctx->display_lock);
+    
+    /* Panel configuration, applied even while content is double buffered */
+    file_ctx->submitted_frame_sequence = ssd1306_queue_frame(device_ctx);
+    
+    return 0;
+}
+
+/**
+ * @brief SSD1306_IOCTL_GET_TICKER handler
+ * @param file_ctx Pointer to per-open file context
+ * @param user_argument Userspace struct ssd1306_ticker
+ * @return 0 on success, negative error code on failure
+ */
+static int ssd1306_ioctl_get_ticker(struct ssd1306_file_context *file_ctx, 
+                                    void __user *user_argument)
+{
+    struct ssd1306_device_context *device_ctx = file_ctx->device_ctx;
+    struct ssd1306_ticker ticker;
+    
+    down_read(&device_ctx->display_lock);
+    ticker = device_ctx->ticker_config;
+    up_read(&device_ctx->display_lock);
+    
+    if (copy_to_user(user_argument, &ticker, sizeof(ticker))) {
+        return -EFAULT;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief SSD1306_IOCTL_SET_WRITE_MODE handler
+ * @param file_ptr Pointer to file structure
+ * @param user_argument Userspace __u32 SSD1306_WRITE_MODE_* value
+ * @return 0 on success, negative error code on failure
+ *
+ * Switching modes rewinds the file since offsets change meaning.
+ */
+static int ssd1306_ioctl_set_write_mode(struct file *file_ptr, void __user *user_argument)
+{
+    struct ssd1306_file_context *file_ctx = file_ptr->private_data;
+    uint32_t write_mode;
+    
+    if (get_user(write_mode, (uint32_t __user *)user_argument)) {
+        return -EFAULT;
+    }
+    
+    if (write_mode > SSD1306_WRITE_MODE_FRAME_DELTA) {
+        return -EINVAL;
+    }
+    
+    file_ctx->write_mode = write_mode;
+    vfs_setpos(file_ptr, 0, MAX_MESSAGE_BUFFER_SIZE);
+    
+    return 0;
+}
+
+/**
+ * @brief SSD1306_IOCTL_GET_VERSION handler
+ * @param user_argument Userspace struct ssd1306_version
+ * @return 0 on success, negative error code on failure
+ */
+static int ssd1306_ioctl_get_version(void __user *user_argument)
+{
+    struct ssd1306_version version = {
+        .api_version = SSD1306_IOCTL_API_VERSION,
+    };
+    
+    if (copy_to_user(user_argument, &version, sizeof(version))) {
+        return -EFAULT;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief Handle SSD1306_IOCTL_SET_DOUBLE_BUFFER
+ * @param file_ctx Per-open file state
+ * @param user_argument Userspace __u32, 1 to enable, 0 to disable
+ * @return 0 on success, negative error code on failure
+ */
+static int ssd1306_ioctl_set_double_buffer(struct ssd1306_file_context *file_ctx, 
+                                           void __user *user_argument)
+{
+    struct ssd1306_device_context *device_ctx = file_ctx->device_ctx;
+    uint32_t enable_double_buffer;
+    
+    if (get_user(enable_double_buffer, (uint32_t __user *)user_argument)) {
+        return -EFAULT;
+    }
+    
+    if (enable_double_buffer > 1) {
+        return -EINVAL;
+    }
+    
+    down_write(&device_ctx->display_lock);
+    ssd1306_set_double_buffered(device_ctx, enable_double_buffer);
+    up_write(&device_ctx->display_lock);
+    
+    file_ctx->submitted_frame_sequence = ssd1306_queue_frame(device_ctx);
+    return 0;
+}
+
+/**
+ * @brief Handle SSD1306_IOCTL_FLIP
+ * @param file_ctx Per-open file state
+ * @param user_argument Userspace __u64 receiving the frame sequence
+ * @return 0 on success, -EINVAL without double buffering
+ *
+ * Never waits for the bus; poll() or GET_FRAME_INFO report when the
+ * returned frame is visible.
+ */
+static int ssd1306_ioctl_flip(struct ssd1306_file_context *file_ctx, void __user *user_argument)
+{
+    struct ssd1306_device_context *device_ctx = file_ctx->device_ctx;
+    uint64_t frame_sequence;
+    
+    down_write(&device_ctx->display_lock);
+    if (!device_ctx->is_double_buffered) {
+        up_write(&device_ctx->display_lock);
+        return -EINVAL;
+    }
+    ssd1306_flip_back_buffer(device_ctx);
+    up_write(&device_ctx->display_lock);
+    
+    frame_sequence = ssd1306_queue_frame(device_ctx);
+    file_ctx->submitted_frame_sequence = frame_sequence;
+    
+    return put_user(frame_sequence, (uint64_t __user *)user_argument);
+}
+
+/**
+ * @brief Draw a 1bpp row-major bitmap into the shadow framebuffer
+ * @param device_ctx Pointer to device context
+ * @param blit Validated blit request
+ * @param bitmap Bitmap copied from userspace
+ *
+ * Pages are read-modify-written so pixels outside the rectangle keep
+ * their value, each under its row lock. Caller holds display_lock for
+ * reading.
+ */
+static void ssd1306_blit_bitmap(struct ssd1306_device_context *device_ctx, 
+                                const struct ssd1306_blit *blit, const uint8_t *bitmap)
+{
+    const struct ssd1306_rect *rect = &blit->rect;
+    uint8_t page_columns[DISPLAY_WIDTH_PIXELS];
+    unsigned int first_page = rect->y / 8;
+    unsigned int last_page = (rect->y + rect->height - 1) / 8;
+    unsigned int page_index, column_index, row;
+    
+    for (page_index = first_page; page_index <= last_page; page_index++) {
+        ssd1306_lock_page_row(device_ctx, page_index);
+        memcpy(page_columns, ssd1306_render_page(device_ctx, page_index), DISPLAY_WIDTH_PIXELS);
+        
+        for (row = max(page_index * 8, (unsigned int)rect->y); 
+             row < min(page_index * 8 + 8, (unsigned int)(rect->y + rect->height)); row++) {
+            const uint8_t *bitmap_row = &bitmap[(row - rect->y) * blit->stride];
+            uint8_t page_bit = BIT(row % 8);
+            
+            for (column_index = 0; column_index < rect->width; column_index++) {
+                if (bitmap_row[column_index / 8] & (0x80 >> (column_index % 8))) {
+                    page_columns[rect->x + column_index] |= page_bit;
+                } else {
+                    page_columns[rect->x + column_index] &= ~page_bit;
+                }
+            }
+        }
+        
+        ssd1306_update_framebuffer_columns(device_ctx, page_index, rect->x, 
+                                           &page_columns[rect->x], rect->width);
+        device_ctx->text_line_valid[page_index] = false;
+        ssd1306_unlock_page_row(device_ctx, page_index);
+    }
+}
+
+/**
+ * @brief Validate a blit request and draw it
+ * @param device_ctx Pointer to device context
+ * @param blit Blit request copied from userspace
+ * @return 0 on success, negative error code on failure
+ */
+static int ssd1306_execute_blit(struct ssd1306_device_context *device_ctx, 
+                                const struct ssd1306_blit *blit)
+{
+    const struct ssd1306_rect *rect = &blit->rect;
+    uint8_t *bitmap;
+    
+    if (blit->reserved || !rect->width || !rect->height || 
+        rect->x + rect->width > device_ctx->panel_width || 
+        rect->y + rect->height > device_ctx->panel_height || 
+        blit->stride < DIV_ROUND_UP(rect->width, 8) || blit->stride > DISPLAY_WIDTH_PIXELS) {
+        return -EINVAL;
+    }
+    
+    bitmap = memdup_user(u64_to_user_ptr(blit->data_ptr), blit->stride * rect->height);
+    if (IS_ERR(bitmap)) {
+        return PTR_ERR(bitmap);
+    }
+    
+    down_read(&device_ctx->display_lock);
+    ssd1306_blit_bitmap(device_ctx, blit, bitmap);
+    up_read(&device_ctx->display_lock);
+    
+    kfree(bitmap);
+    return 0;
+}
+
+/**
+ * @brief Run a list of binary operations
+ * @param file_ctx Pointer to per-open file context
+ * @param operations Operations copied from userspace
+ * @param operation_count Number of entries in operations
+ * @return 0 on success, negative error code of the first failing operation
+ *
+ * Display settings are sent right away; pixel changes are queued as one
+ * frame once all operations have run, including after a failure.
+ */
+static int ssd1306_execute_operations(struct ssd1306_file_context *file_ctx, 
+                                      const struct ssd1306_op *operations, 
+                                      unsigned int operation_count)
+{
+    struct ssd1306_device_context *device_ctx = file_ctx->device_ctx;
+    const struct ssd1306_op *operation;
+    bool pixels_changed = false;
+    unsigned int operation_index;
+    int result = 0;
+    
+    for (operation_index = 0; operation_index < operation_count && !result; operation_index++) {
+        operation = &operations[operation_index];
+        if (operation->reserved) {
+            result = -EINVAL;
+            break;
+        }
+        
+        switch (operation->opcode) {
+        case SSD1306_OP_SET_CONTRAST:
+            if (operation->arg.value > 0xFF) {
+                result = -EINVAL;
+                break;
+            }
+            result = ssd1306_set_display_brightness(device_ctx, operation->arg.value);
+            break;
+        case SSD1306_OP_SET_INVERT:
+            result = ssd1306_set_display_inverted(device_ctx, operation->arg.value != 0);
+            break;
+        case SSD1306_OP_SET_POWER:
+            result = ssd1306_set_display_power(device_ctx, operation->arg.value != 0);
+            break;
+        case SSD1306_OP_SET_CURSOR:
+            down_write(&device_ctx->display_lock);
+            result = ssd1306_set_cursor_position(device_ctx, operation->arg.cursor.line, 
+                                                 operation->arg.cursor.column);
+            up_write(&device_ctx->display_lock);
+            break;
+        case SSD1306_OP_BLIT:
+            result = ssd1306_execute_blit(device_ctx, &operation->arg.blit);
+            pixels_changed |= !result;
+            break;
+        default:
+            result = -EINVAL;
+            break;
+        }
+    }
+    
+    if (pixels_changed) {
+        file_ctx->submitted_frame_sequence = ssd1306_schedule_flush(device_ctx);
+    }
+    
+    return result;
+}
+
+/**
+ * @brief Single-operation ioctl handler (contrast, invert, power, cursor, blit)
+ * @param file_ctx Pointer to per-open file context
+ * @param opcode SSD1306_OP_* matching the ioctl
+ * @param user_argument Userspace argument of the ioctl
+ * @param argument_size Size of the argument
+ * @return 0 on success, negative error code on failure
+ */
+static int ssd1306_ioctl_single_operation(struct ssd1306_file_context *file_ctx, uint32_t opcode, 
+                                          void __user *user_argument, size_t argument_size)
+{
+    struct ssd1306_op operation = {
+        .opcode = opcode,
+    };
+    
+    if (copy_from_user(&operation.arg, user_argument, argument_size)) {
+        return -EFAULT;
+    }
+    
+    return ssd1306_execute_operations(file_ctx, &operation, 1);
+}
+
+/**
+ * @brief SSD1306_IOCTL_BATCH handler
+ * @param file_ctx Pointer to per-open file context
+ * @param user_argument Userspace struct ssd1306_batch
+ * @return 0 on success, negative error code on failure
+ */
+static int ssd1306_ioctl_batch(struct ssd1306_file_context *file_ctx, 
+                               void __user *user_argument)
+{
+    struct ssd1306_batch batch;
+    struct ssd1306_op *operations;
+    int result;
+    
+    if (copy_from_user(&batch, user_argument, sizeof(batch))) {
+        return -EFAULT;
+    }
+    
+    if (batch.reserved || !batch.op_count || batch.op_count > SSD1306_MAX_BATCH_OPS) {
+        return -EINVAL;
+    }
+    
+    operations = memdup_user(u64_to_user_ptr(batch.ops_ptr), 
+                             batch.op_count * sizeof(*operations));
+    if (IS_ERR(operations)) {
+        return PTR_ERR(operations);
+    }
+    
+    result = ssd1306_execute_operations(file_ctx, operations, batch.op_count);
+    
+    kfree(operations);
+    return result;
+}
+
+/**
+ * @brief Character device poll operation
+ * @param file_ptr Pointer to file structure
+ * @param poll_table_ptr Poll table
+ * @return Event mask
+ *
+ * EPOLLOUT is reported once every frame this file submitted is visible
+ * on the panel, so a pacing loop can sleep on the fd between frames.
+ * EPOLLERR is reported while the last flush failed, EPOLLHUP once the
+ * panel has been removed.
+ */
+static __poll_t ssd1306_char_device_poll(struct file *file_ptr, poll_table *poll_table_ptr)
+{
+    struct ssd1306_file_context *file_ctx = file_ptr->private_data;
+    struct ssd1306_device_context *device_ctx = file_ctx->device_ctx;
+    __poll_t event_mask = 0;
+    
+    poll_wait(file_ptr, &device_ctx->frame_wait_queue, poll_table_ptr);
+    
+    if (ssd1306_file_operation_begin(device_ctx)) {
+        return EPOLLHUP | EPOLLERR;
+    }
+    
+    down_read(&device_ctx->display_lock);
+    if (device_ctx->frame_sequence_completed >= file_ctx->submitted_frame_sequence) {
+        event_mask |= EPOLLOUT | EPOLLWRNORM;
+    }
+    if (device_ctx->last_flush_result) {
+        event_mask |= EPOLLERR;
+    }
+    up_read(&device_ctx->display_lock);
+    ssd1306_file_operation_end(device_ctx);
+    
+    return event_mask;
+}
+
+/**
+ * @brief Run one ioctl command
+ * @param file_ptr Pointer to file structure
+ * @param command ioctl command number
+ * @param argument ioctl argument (userspace pointer)
+ * @return 0 on success, negative error code on failure
+ */
+static long ssd1306_dispatch_ioctl(struct file *file_ptr, unsigned int command, 
+                                   unsigned long argument)
+{
+    struct ssd1306_file_context *file_ctx = file_ptr->private_data;
+    void __user *user_argument = (void __user *)argument;
+    
+    switch (command) {
+    case SSD1306_IOCTL_FLUSH:
+        return ssd1306_ioctl_flush(file_ctx, user_argument);
+    case SSD1306_IOCTL_GET_FRAME_INFO:
+        return ssd1306_ioctl_get_frame_info(file_ctx, user_argument);
+    case SSD1306_IOCTL_SET_TICKER:
+        return ssd1306_ioctl_set_ticker(file_ctx, user_argument);
+    case SSD1306_IOCTL_GET_TICKER:
+        return ssd1306_ioctl_get_ticker(file_ctx, user_argument);
+    case SSD1306_IOCTL_SET_WRITE_MODE:
+        return ssd1306_ioctl_set_write_mode(file_ptr, user_argument);
+    case SSD1306_IOCTL_GET_VERSION:
+        return ssd1306_ioctl_get_version(user_argument);
+    case SSD1306_IOCTL_SET_CONTRAST:
+        return ssd1306_ioctl_single_operation(file_ctx, SSD1306_OP_SET_CONTRAST, 
+                                              user_argument, sizeof(__u32));
+    case SSD1306_IOCTL_SET_INVERT:
+        return ssd1306_ioctl_single_operation(file_ctx, SSD1306_OP_SET_INVERT, 
+                                              user_argument, sizeof(__u32));
+    case SSD1306_IOCTL_SET_POWER:
+        return ssd1306_ioctl_single_operation(file_ctx, SSD1306_OP_SET_POWER, 
+                                              user_argument, sizeof(__u32));
+    case SSD1306_IOCTL_SET_CURSOR:
+        return ssd1306_ioctl_single_operation(file_ctx, SSD1306_OP_SET_CURSOR, 
+                                              user_argument, sizeof(struct ssd1306_cursor));
+    case SSD1306_IOCTL_BLIT:
+        return ssd1306_ioctl_single_operation(file_ctx, SSD1306_OP_BLIT, 
+                                              user_argument, sizeof(struct ssd1306_blit));
+    case SSD1306_IOCTL_BATCH:
+        return ssd1306_ioctl_batch(file_ctx, user_argument);
+    case SSD1306_IOCTL_SET_DOUBLE_BUFFER:
+        return ssd1306_ioctl_set_double_buffer(file_ctx, user_argument);
+    case SSD1306_IOCTL_FLIP:
+        return ssd1306_ioctl_flip(file_ctx, user_argument);
+    default:
+        return -ENOTTY;
+    }
+}
+
+/**
+ * @brief Character device ioctl operation
+ * @param file_ptr Pointer to file structure
+ * @param command ioctl command number
+ * @param argument ioctl argument (userspace pointer)
+ * @return 0 on success, negative error code on failure
+ */
+static long ssd1306_char_device_ioctl(struct file *file_ptr, unsigned int command, 
+                                      unsigned long argument)
+{
+    struct ssd1306_file_context *file_ctx = file_ptr->private_data;
+    long result;
+    
+    result = ssd1306_file_operation_begin(file_ctx->device_ctx);
+    if (result) {
+        return result;
+    }
+    
+    result = ssd1306_dispatch_ioctl(file_ptr, command, argument);
+    ssd1306_file_operation_end(file_ctx->device_ctx);
+    return result;
+}
+
+#if IS_ENABLED(CONFIG_SSD1306_FBDEV)
+
+/* Framebuffer Device (fbdev) Implementation */
+
+/**
+ * @brief Convert the 1bpp linear framebuffer into page format and flush
+ * @param device_ctx Pointer to device context
+ *
+ * The fbdev memory is row-major with LSB-first bits; the panel wants
+ * columns of 8 vertical pixels. The converted frame goes through the
+ * shadow framebuffer so only columns that really changed hit the bus,
+ * and the transfer itself runs on the flush worker.
+ */
+static void ssd1306_fbdev_update_display(struct ssd1306_device_context *device_ctx)
+{
+    const uint8_t *video_memory = device_ctx->fbdev_video_memory;
+    unsigned int line_length = device_ctx->panel_width / 8;
+    unsigned int page_index, column_index, bit_index;
+    uint8_t page_byte;
+    
+    down_write(&device_ctx->display_lock);
+    
+    for (page_index = 0; page_index < device_ctx->panel_pages; page_index++) {
+        for (column_index = 0; column_index < device_ctx->panel_width; column_index++) {
+            page_byte = 0;
+            for (bit_index = 0; bit_index < 8; bit_index++) {
+                unsigned int row = page_index * 8 + bit_index;
+                uint8_t source_byte = video_memory[row * line_length + column_index / 8];
+                
+                if (source_byte & BIT(column_index % 8)) {
+                    page_byte |= BIT(bit_index);
+                }
+            }
+            device_ctx->compose_framebuffer[page_index][column_index] = page_byte;
+        }
+    }
+    
+    ssd1306_commit_compose_framebuffer(device_ctx);
+    ssd1306_invalidate_text_cells(device_ctx);
+    
+    up_write(&device_ctx->display_lock);
+    
+    ssd1306_schedule_flush(device_ctx);
+}
+
+/**
+ * @brief Deferred I/O callback, runs after mmap writes settle
+ * @param info Pointer to framebuffer info
+ * @param pagelist List of touched memory pages
+ */
+static void ssd1306_fbdev_deferred_io(struct fb_info *info, struct list_head *pagelist)
+{
+    ssd1306_fbdev_update_display(info->par);
+}
+
+/**
+ * @brief fbdev write operation
+ * @param info Pointer to framebuffer info
+ * @param user_buffer User space buffer containing pixel data
+ * @param write_count Number of bytes to write
+ * @param file_position File position pointer
+ * @return Number of bytes written or negative error code
+ */
+static ssize_t ssd1306_fbdev_write(struct fb_info *info, const char __user *user_buffer, 
+                                   size_t write_count, loff_t *file_position)
+{
+    ssize_t result = fb_sys_write(info, user_buffer, write_count, file_position);
+    
+    if (result > 0) {
+        ssd1306_fbdev_update_display(info->par);
+    }
+    return result;
+}
+
+/**
+ * @brief fbdev blank operation, maps to display ON/OFF
+ * @param blank_mode FB_BLANK_* mode
+ * @param info Pointer to framebuffer info
+ * @return 0 on success, negative error code on failure
+ */
+static int ssd1306_fbdev_blank(int blank_mode, struct fb_info *info)
+{
+    return ssd1306_set_display_power(info->par, blank_mode == FB_BLANK_UNBLANK);
+}
+
+static void ssd1306_fbdev_fillrect(struct fb_info *info, const struct fb_fillrect *rect)
+{
+    sys_fillrect(info, rect);
+    ssd1306_fbdev_update_display(info->par);
+}
+
+static void ssd1306_fbdev_copyarea(struct fb_info *info, const struct fb_copyarea *area)
+{
+    sys_copyarea(info, area);
+    ssd1306_fbdev_update_display(info->par);
+}
+
+static void ssd1306_fbdev_imageblit(struct fb_info *info, const struct fb_image *image)
+{
+    sys_imageblit(info, image);
+    ssd1306_fbdev_update_display(info->par);
+}
+
+/**
+ * @brief Framebuffer operations structure
+ *
+ * Not const: fb_deferred_io_init() installs fb_mmap through info->fbops
+ * on the 5.4 target, where fb_info also holds a non-const pointer.
+ */
+static struct fb_ops ssd1306_fbdev_operations = {
+    .owner = THIS_MODULE,
+    .fb_read = fb_sys_read,
+    .fb_write = ssd1306_fbdev_write,
+    .fb_blank = ssd1306_fbdev_blank,
+    .fb_fillrect = ssd1306_fbdev_fillrect,
+    .fb_copyarea = ssd1306_fbdev_copyarea,
+    .fb_imageblit = ssd1306_fbdev_imageblit,
+};
+
+/**
+ * @brief Register /dev/fbN backed by deferred I/O
+ * @param device_ctx Pointer to device context
+ * @return 0 on success, negative error code on failure
+ */
+static int ssd1306_register_framebuffer(struct ssd1306_device_context *device_ctx)
+{
+    struct device *parent_device = &device_ctx->i2c_client_ptr->dev;
+    size_t video_memory_size = device_ctx->panel_width * device_ctx->panel_height / 8;
+    struct fb_deferred_io *deferred_io;
+    struct fb_info *info;
+    int result;
+    
+    info = framebuffer_alloc(0, parent_device);
+    if (!info) {
+        return -ENOMEM;
+    }
+    
+    deferred_io = devm_kzalloc(parent_device, sizeof(*deferred_io), GFP_KERNEL);
+    device_ctx->fbdev_video_memory = vzalloc(PAGE_ALIGN(video_memory_size));
+    if (!deferred_io || !device_ctx->fbdev_video_memory) {
+        result = -ENOMEM;
+        goto memory_allocation_failed;
+    }
+    
+    /* Coalesce mmap writes, flush at most fbdev_refresh_rate times per second */
+    deferred_io->delay = HZ / max(fbdev_refresh_rate, 1U);
+    deferred_io->deferred_io = ssd1306_fbdev_deferred_io;
+    
+    info->par = device_ctx;
+    info->fbops = &ssd1306_fbdev_operations;
+    info->fbdefio = deferred_io;
+    info->screen_buffer = device_ctx->fbdev_video_memory;
+    info->flags = FBINFO_VIRTFB;
+    
+    strscpy(info->fix.id, "SSD1306", sizeof(info->fix.id));
+    info->fix.type = FB_TYPE_PACKED_PIXELS;
+    info->fix.visual = FB_VISUAL_MONO10;
+    info->fix.accel = FB_ACCEL_NONE;
+    info->fix.line_length = device_ctx->panel_width / 8;
+    info->fix.smem_len = video_memory_size;
+    
+    info->var.xres = device_ctx->panel_width;
+    info->var.yres = device_ctx->panel_height;
+    info->var.xres_virtual = device_ctx->panel_width;
+    info->var.yres_virtual = device_ctx->panel_height;
+    info->var.bits_per_pixel = 1;
+    info->var.red.length = 1;
+    info->var.green.length = 1;
+    info->var.blue.length = 1;
+    
+    fb_deferred_io_init(info);
+    
+    result = register_framebuffer(info);
+    if (result) {
+        dev_err(parent_device, "Failed to register framebuffer: %d\n", result);
+        goto framebuffer_registration_failed;
+    }
+    
+    device_ctx->framebuffer_info = info;
+    dev_info(parent_device, "Framebuffer device registered: fb%d\n", info->node);
+    return 0;
+    
+    /* Error cleanup */
+framebuffer_registration_failed:
+    fb_deferred_io_cleanup(info);
+memory_allocation_failed:
+    vfree(device_ctx->fbdev_video_memory);
+    device_ctx->fbdev_video_memory = NULL;
+    framebuffer_release(info);
+    return result;
+}
+
+/**
+ * @brief Unregister framebuffer device
+ * @param device_ctx Pointer to device context
+ */
+static void ssd1306_unregister_framebuffer(struct ssd1306_device_context *device_ctx)
+{
+    struct fb_info *info = device_ctx->framebuffer_info;
+    
+    if (!info) {
+        return;
+    }
+    
+    unregister_framebuffer(info);
+    fb_deferred_io_cleanup(info);
+    vfree(device_ctx->fbdev_video_memory);
+    framebuffer_release(info);
+    device_ctx->framebuffer_info = NULL;
+}
+
+#else /* !CONFIG_SSD1306_FBDEV */
+
+static int ssd1306_register_framebuffer(struct ssd1306_device_context *device_ctx)
+{
+    return 0;
+}
+
+static void ssd1306_unregister_framebuffer(struct ssd1306_device_context *device_ctx)
+{
+}
+
+#endif /* CONFIG_SSD1306_FBDEV */
+
+#if IS_ENABLED(CONFIG_SSD1306_DRM)
+
+/* DRM/KMS Front End Implementation */
+
+/**
+ * @brief DRM device wrapper
+ *
+ * Allocated with devm_drm_dev_alloc(); the display pipe feeds the same
+ * shadow framebuffer and flush path as the character device.
+ */
+struct ssd1306_drm_device {
+    struct drm_device drm;
+    struct drm_simple_display_pipe display_pipe;
+    struct drm_connector connector;
+    struct drm_display_mode display_mode;        /* Sized to the panel geometry */
+    struct ssd1306_device_context *device_ctx;
+    bool holds_panel;                            /* Runtime PM reference while enabled */
+};
+
+#define to_ssd1306_drm_device(drm_ptr) container_of(drm_ptr, struct ssd1306_drm_device, drm)
+
+static const uint32_t ssd1306_drm_formats[] = {
+    DRM_FORMAT_XRGB8888,
+#ifdef DRM_FORMAT_R1
+    DRM_FORMAT_R1,
+#endif
+};
+
+/**
+ * @brief Check whether a framebuffer pixel should be lit
+ * @param framebuffer Pointer to DRM framebuffer
+ * @param vaddr Kernel mapping of the framebuffer memory
+ * @param x Column in pixels
+ * @param y Row in pixels
+ * @return true if the pixel is on
+ */
+static bool ssd1306_drm_pixel_is_lit(const struct drm_framebuffer *framebuffer, 
+                                     const void *vaddr, unsigned int x, unsigned int y)
+{
+    const uint8_t *line = (const uint8_t *)vaddr + y * framebuffer->pitches[0];
+    uint32_t pixel;
+    unsigned int luminance;
+    
+    switch (framebuffer->format->format) {
+#ifdef DRM_FORMAT_R1
+    case DRM_FORMAT_R1:
+        return line[x / 8] & (0x80 >> (x % 8));
+#endif
+    case DRM_FORMAT_XRGB8888:
+    default:
+        pixel = ((const uint32_t *)line)[x];
+        /* BT.601 luma, threshold at half intensity */
+        luminance = (((pixel >> 16) & 0xFF) * 77 + 
+                     ((pixel >> 8) & 0xFF) * 150 + 
+                     (pixel & 0xFF) * 29) >> 8;
+        return luminance >= 128;
+    }
+}
+
+/**
+ * @brief Convert one damage rectangle into page format in the shadow buffer
+ * @param device_ctx Pointer to device context
+ * @param framebuffer Pointer to DRM framebuffer
+ * @param vaddr Kernel mapping of the framebuffer memory
+ * @param damage_clip Damaged rectangle in framebuffer coordinates
+ *
+ * Rows are widened to whole pages since the panel stores 8 vertical pixels
+ * per byte; columns outside the clip are never touched. Caller holds
+ * display_lock for writing.
+ */
+static void ssd1306_drm_blit_rect(struct ssd1306_device_context *device_ctx, 
+                                  const struct drm_framebuffer *framebuffer, 
+                                  const void *vaddr, const struct drm_rect *damage_clip)
+{
+    uint8_t page_columns[DISPLAY_WIDTH_PIXELS];
+    unsigned int first_page = damage_clip->y1 / 8;
+    unsigned int last_page = (damage_clip->y2 - 1) / 8;
+    unsigned int page_index, column_index, bit_index, row;
+    
+    for (page_index = first_page; page_index <= last_page; page_index++) {
+        for (column_index = damage_clip->x1; column_index < damage_clip->x2; column_index++) {
+            uint8_t page_byte = 0;
+            
+            for (bit_index = 0; bit_index < 8; bit_index++) {
+                row = page_index * 8 + bit_index;
+                if (row < framebuffer->height && 
+                    ssd1306_drm_pixel_is_lit(framebuffer, vaddr, column_index, row)) {
+                    page_byte |= BIT(bit_index);
+                }
+            }
+            page_columns[column_index - damage_clip->x1] = page_byte;
+        }
+        
+        ssd1306_update_framebuffer_columns(device_ctx, page_index, damage_clip->x1, 
+                                           page_columns, damage_clip->x2 - damage_clip->x1);
+    }
+    
+    ssd1306_invalidate_text_cells(device_ctx);
+}
+
+/**
+ * @brief Plane update, flushes only the damaged rectangles
+ * @param display_pipe Pointer to simple display pipe
+ * @param old_plane_state Previous plane state for damage tracking
+ */
+static void ssd1306_drm_pipe_update(struct drm_simple_display_pipe *display_pipe, 
+                                    struct drm_plane_state *old_plane_state)
+{
+    struct ssd1306_drm_device *ssd1306_drm = to_ssd1306_drm_device(display_pipe->crtc.dev);
+    struct ssd1306_device_context *device_ctx = ssd1306_drm->device_ctx;
+    struct drm_plane_state *plane_state = display_pipe->plane.state;
+    struct drm_shadow_plane_state *shadow_plane_state = to_drm_shadow_plane_state(plane_state);
+    struct drm_atomic_helper_damage_iter damage_iter;
+    struct drm_rect damage_clip;
+    int device_index;
+    
+    if (!plane_state->fb || !display_pipe->crtc.state->active) {
+        return;
+    }
+    
+    if (!drm_dev_enter(&ssd1306_drm->drm, &device_index)) {
+        return;
+    }
+    
+    down_write(&device_ctx->display_lock);
+    
+    drm_atomic_helper_damage_iter_init(&damage_iter, old_plane_state, plane_state);
+    drm_atomic_for_each_plane_damage(&damage_iter, &damage_clip) {
+        ssd1306_drm_blit_rect(device_ctx, plane_state->fb, 
+                              shadow_plane_state->map[0].vaddr, &damage_clip);
+    }
+    
+    up_write(&device_ctx->display_lock);
+    
+    ssd1306_schedule_flush(device_ctx);
+    drm_dev_exit(device_index);
+}
+
+/**
+ * @brief Pipe enable, pushes the whole frame and turns the panel on
+ * @param display_pipe Pointer to simple display pipe
+ * @param crtc_state New CRTC state
+ * @param plane_state New plane state
+ */
+static void ssd1306_drm_pipe_enable(struct drm_simple_display_pipe *display_pipe, 
+                                    struct drm_crtc_state *crtc_state, 
+                                    struct drm_plane_state *plane_state)
+{
+    struct ssd1306_drm_device *ssd1306_drm = to_ssd1306_drm_device(display_pipe->crtc.dev);
+    struct ssd1306_device_context *device_ctx = ssd1306_drm->device_ctx;
+    struct drm_shadow_plane_state *shadow_plane_state = to_drm_shadow_plane_state(plane_state);
+    struct drm_rect full_frame = {
+        .x1 = 0, .y1 = 0, .x2 = device_ctx->panel_width, .y2 = device_ctx->panel_height,
+    };
+    int device_index;
+    
+    if (!drm_dev_enter(&ssd1306_drm->drm, &device_index)) {
+        return;
+    }
+    
+    /* A static scanout gets no writes, keep idle power-off away from it */
+    ssd1306_keep_panel_awake(device_ctx, &ssd1306_drm->holds_panel, true);
+    
+    if (plane_state->fb) {
+        down_write(&device_ctx->display_lock);
+        ssd1306_drm_blit_rect(device_ctx, plane_state->fb, 
+                              shadow_plane_state->map[0].vaddr, &full_frame);
+        up_write(&device_ctx->display_lock);
+    }
+    
+    /* Content first, then light the panel */
+    if (!ssd1306_panel_access_begin(device_ctx)) {
+        mutex_lock(&device_ctx->bus_lock);
+        if (device_ctx->panel_needs_reinit) {
+            device_ctx->is_display_enabled = true;
+        } else if (!ssd1306_flush_dirty_pages(device_ctx)) {
+            if (!ssd1306_send_i2c_command(device_ctx, SSD1306_CMD_DISPLAY_ON)) {
+                device_ctx->is_display_enabled = true;
+            } else {
+                ssd1306_schedule_panel_recovery(device_ctx);
+            }
+        }
+        mutex_unlock(&device_ctx->bus_lock);
+        ssd1306_panel_access_end(device_ctx);
+    }
+    
+    drm_dev_exit(device_index);
+}
+
+/**
+ * @brief Pipe disable, turns the panel off
+ * @param display_pipe Pointer to simple display pipe
+ */
+static void ssd1306_drm_pipe_disable(struct drm_simple_display_pipe *display_pipe)
+{
+    struct ssd1306_drm_device *ssd1306_drm = to_ssd1306_drm_device(display_pipe->crtc.dev);
+    struct ssd1306_device_context *device_ctx = ssd1306_drm->device_ctx;
+    int device_index;
+    
+    if (drm_dev_enter(&ssd1306_drm->drm, &device_index)) {
+        ssd1306_set_display_power(device_ctx, false);
+        drm_dev_exit(device_index);
+    }
+    
+    /* Also after unplug, so the reference taken on enable is balanced */
+    ssd1306_keep_panel_awake(device_ctx, &ssd1306_drm->holds_panel, false);
+}
+
+static const struct drm_simple_display_pipe_funcs ssd1306_drm_pipe_funcs = {
+    .enable = ssd1306_drm_pipe_enable,
+    .disable = ssd1306_drm_pipe_disable,
+    .update = ssd1306_drm_pipe_update,
+    DRM_GEM_SIMPLE_DISPLAY_PIPE_SHADOW_PLANE_FUNCS,
+};
+
+/**
+ * @brief Report the single fixed panel mode
+ * @param connector Pointer to DRM connector
+ * @return Number of modes added
+ */
+static int ssd1306_drm_connector_get_modes(struct drm_connector *connector)
+{
+    struct ssd1306_drm_device *ssd1306_drm = to_ssd1306_drm_device(connector->dev);
+    struct drm_display_mode *mode;
+    
+    mode = drm_mode_duplicate(connector->dev, &ssd1306_drm->display_mode);
+    if (!mode) {
+        return 0;
+    }
+    
+    mode->type |= DRM_MODE_TYPE_PREFERRED;
+    drm_mode_set_name(mode);
+    drm_mode_probed_add(connector, mode);
+    
+    connector->display_info.width_mm = mode->width_mm;
+    connector->display_info.height_mm = mode->height_mm;
+    
+    return 1;
+}
+
+static const struct drm_connector_helper_funcs ssd1306_drm_connector_helper_funcs = {
+    .get_modes = ssd1306_drm_connector_get_modes,
+};
+
+static const struct drm_connector_funcs ssd1306_drm_connector_funcs = {
+    .reset = drm_atomic_helper_connector_reset,
+    .fill_modes = drm_helper_probe_single_connector_modes,
+    .destroy = drm_connector_cleanup,
+    .atomic_duplicate_state = drm_atomic_helper_connector_duplicate_state,
+    .atomic_destroy_state = drm_atomic_helper_connector_destroy_state,
+};
+
+static const struct drm_mode_config_funcs ssd1306_drm_mode_config_funcs = {
+    .fb_create = drm_gem_fb_create_with_dirty,
+    .atomic_check = drm_atomic_helper_check,
+    .atomic_commit = drm_atomic_helper_commit,
+};
+
+DEFINE_DRM_GEM_FOPS(ssd1306_drm_fops);
+
+static const struct drm_driver ssd1306_drm_driver = {
+    .driver_features = DRIVER_GEM | DRIVER_MODESET | DRIVER_ATOMIC,
+    DRM_GEM_SHMEM_DRIVER_OPS,
+    .fops = &ssd1306_drm_fops,
+    .name = DEVICE_NAME,
+    .desc = "SSD1306 OLED Display",
+    .date = "20250614",
+    .major = 1,
+    .minor = 0,
+};
+
+/**
+ * @brief Register the DRM/KMS front end
+ * @param device_ctx Pointer to device context
+ * @return 0 on success, negative error code on failure
+ */
+static int ssd1306_register_drm_device(struct ssd1306_device_context *device_ctx)
+{
+    struct device *parent_device = &device_ctx->i2c_client_ptr->dev;
+    struct ssd1306_drm_device *ssd1306_drm;
+    struct drm_device *drm;
+    int result;
+    
+    ssd1306_drm = devm_drm_dev_alloc(parent_device, &ssd1306_drm_driver, 
+                                     struct ssd1306_drm_device, drm);
+    if (IS_ERR(ssd1306_drm)) {
+        return PTR_ERR(ssd1306_drm);
+    }
+    
+    ssd1306_drm->device_ctx = device_ctx;
+    drm = &ssd1306_drm->drm;
+    
+    result = drmm_mode_config_init(drm);
+    if (result) {
+        return result;
+    }
+    
+    /* 0.96" 128x64 glass is 22x11 mm, smaller modules keep the pixel pitch */
+    ssd1306_drm->display_mode = (struct drm_display_mode) {
+        DRM_SIMPLE_MODE(device_ctx->panel_width, device_ctx->panel_height, 
+                        22 * device_ctx->panel_width / DISPLAY_WIDTH_PIXELS, 
+                        11 * device_ctx->panel_height / DISPLAY_HEIGHT_PIXELS),
+    };
+    
+    drm->mode_config.min_width = device_ctx->panel_width;
+    drm->mode_config.max_width = device_ctx->panel_width;
+    drm->mode_config.min_height = device_ctx->panel_height;
+    drm->mode_config.max_height = device_ctx->panel_height;
+    drm->mode_config.preferred_depth = 24;
+    drm->mode_config.funcs = &ssd1306_drm_mode_config_funcs;
+    
+    drm_connector_helper_add(&ssd1306_drm->connector, &ssd1306_drm_connector_helper_funcs);
+    result = drm_connector_init(drm, &ssd1306_drm->connector, 
+                                &ssd1306_drm_connector_funcs, DRM_MODE_CONNECTOR_Unknown);
+    if (result) {
+        return result;
+    }
+    
+    result = drm_simple_display_pipe_init(drm, &ssd1306_drm->display_pipe, 
+                                          &ssd1306_drm_pipe_funcs, 
+                                          ssd1306_drm_formats, ARRAY_SIZE(ssd1306_drm_formats), 
+                                          NULL, &ssd1306_drm->connector);
+    if (result) {
+        return result;
+    }
+    
+    /* Let userspace pass FB_DAMAGE_CLIPS so updates stay partial */
+    drm_plane_enable_fb_damage_clips(&ssd1306_drm->display_pipe.plane);
+    
+    drm_mode_config_reset(drm);
+    
+    result = drm_dev_register(drm, 0);
+    if (result) {
+        dev_err(parent_device, "Failed to register DRM device: %d\n", result);
+        return result;
+    }
+    
+    /* Generic fbdev emulation on top of the DRM device */
+    drm_fbdev_generic_setup(drm, 0);
+    
+    device_ctx->drm_device_ptr = drm;
+    dev_info(parent_device, "DRM device registered: card%d\n", drm->primary->index);
+    return 0;
+}
+
+/**
+ * @brief Unregister the DRM/KMS front end
+ * @param device_ctx Pointer to device context
+ */
+static void ssd1306_unregister_drm_device(struct ssd1306_device_context *device_ctx)
+{
+    struct drm_device *drm = device_ctx->drm_device_ptr;
+    
+    if (!drm) {
+        return;
+    }
+    
+    drm_dev_unplug(drm);
+    drm_atomic_helper_shutdown(drm);
+    device_ctx->drm_device_ptr = NULL;
+}
+
+#else /* !CONFIG_SSD1306_DRM */
+
+static int ssd1306_register_drm_device(struct ssd1306_device_context *device_ctx)
+{
+    return 0;
+}
+
+static void ssd1306_unregister_drm_device(struct ssd1306_device_context *device_ctx)
+{
+}
+
+#endif /* CONFIG_SSD1306_DRM */
+
+/**
+ * @brief Runtime suspend: display off and charge pump off
+ * @param dev Pointer to I2C client device
+ * @return 0 on success, negative error code on failure
+ *
+ * GDDRAM keeps its content in sleep mode, so nothing has to be saved.
+ */
+static int __maybe_unused ssd1306_runtime_suspend(struct device *dev)
+{
+    struct ssd1306_device_context *device_ctx = dev_get_drvdata(dev);
+    struct ssd1306_command_list sleep_commands;
+    int result;
+    
+    ssd1306_command_list_init(&sleep_commands);
+    ssd1306_command_list_add(&sleep_commands, SSD1306_CMD_DISPLAY_OFF);
+    ssd1306_command_list_add(&sleep_commands, SSD1306_CMD_CHARGE_PUMP);
+    ssd1306_command_list_add(&sleep_commands, SSD1306_CHARGE_PUMP_DISABLE);
+    
+    mutex_lock(&device_ctx->bus_lock);
+    result = ssd1306_send_command_list(device_ctx, &sleep_commands);
+    if (result) {
+        /* Panel state unknown; report success so runtime PM is not wedged */
+        ssd1306_schedule_panel_recovery(device_ctx);
+    }
+    mutex_unlock(&device_ctx->bus_lock);
+    
+    return 0;
+}
+
+/**
+ * @brief Runtime resume: restart the charge pump and restore the panel
+ * @param dev Pointer to I2C client device
+ * @return 0 on success, negative error code on failure
+ *
+ * After system sleep the panel may have been unpowered, so it is fully
+ * re-initialized and the shadow framebuffer replayed. The time taken is
+ * recorded for the wake_latency_us attributes.
+ */
+static int __maybe_unused ssd1306_runtime_resume(struct device *dev)
+{
+    struct ssd1306_device_context *device_ctx = dev_get_drvdata(dev);
+    struct ssd1306_command_list wake_commands;
+    ktime_t wake_start = ktime_get();
+    ktime_t wake_latency;
+    int result;
+    
+    mutex_lock(&device_ctx->bus_lock);
+    if (device_ctx->panel_needs_reinit) {
+        result = ssd1306_restore_panel_state(device_ctx);
+        if (!result) {
+            device_ctx->panel_needs_reinit = false;
+        }
+    } else {
+        ssd1306_command_list_init(&wake_commands);
+        ssd1306_command_list_add(&wake_commands, SSD1306_CMD_CHARGE_PUMP);
+        ssd1306_command_list_add(&wake_commands, SSD1306_CHARGE_PUMP_ENABLE);
+        if (device_ctx->is_display_enabled) {
+            ssd1306_command_list_add(&wake_commands, SSD1306_CMD_DISPLAY_ON);
+        }
+        result = ssd1306_send_command_list(device_ctx, &wake_commands);
+    }
+    if (result) {
+        /* Leave runtime PM usable, the recovery worker brings the panel back */
+        ssd1306_schedule_panel_recovery(device_ctx);
+    }
+    mutex_unlock(&device_ctx->bus_lock);
+    
+    if (result) {
+        return 0;
+    }
+    
+    wake_latency = ktime_sub(ktime_get(), wake_start);
+    
+    down_write(&device_ctx->display_lock);
+    device_ctx->last_wake_latency = wake_latency;
+    if (ktime_after(wake_latency, device_ctx->max_wake_latency)) {
+        device_ctx->max_wake_latency = wake_latency;
+    }
+    device_ctx->wake_count++;
+    up_write(&device_ctx->display_lock);
+    
+    return 0;
+}
+
+/**
+ * @brief PM notifier: send queued frames before the freezer stops the workqueue
+ * @param notifier Pointer to embedded notifier block
+ * @param event PM_* event
+ * @param unused Unused
+ * @return NOTIFY_DONE
+ *
+ * flush_workqueue is freezable, so by the time device suspend callbacks
+ * run it no longer executes work and cannot be drained from there.
+ */
+static int ssd1306_pm_notifier_callback(struct notifier_block *notifier, unsigned long event, 
+                                        void *unused)
+{
+    struct ssd1306_device_context *device_ctx = 
+        container_of(notifier, struct ssd1306_device_context, pm_notifier);
+    
+    if (event == PM_SUSPEND_PREPARE || event == PM_HIBERNATION_PREPARE) {
+        flush_workqueue(device_ctx->flush_workqueue);
+    }
+    
+    return NOTIFY_DONE;
+}
+
+/**
+ * @brief Devm action: stop receiving PM notifications
+ * @param data Pointer to device context
+ */
+static void ssd1306_unregister_pm_notifier(void *data)
+{
+    struct ssd1306_device_context *device_ctx = data;
+    
+    unregister_pm_notifier(&device_ctx->pm_notifier);
+}
+
+/**
+ * @brief System suspend: sleep the panel
+ * @param dev Pointer to I2C client device
+ * @return 0 on success, negative error code on failure
+ *
+ * Frames queued before the freeze were sent by the PM notifier; later
+ * ones wait in the frozen workqueue and go out after resume.
+ */
+static int __maybe_unused ssd1306_system_suspend(struct device *dev)
+{
+    struct ssd1306_device_context *device_ctx = dev_get_drvdata(dev);
+    int result;
+    
+    result = pm_runtime_force_suspend(dev);
+    if (result) {
+        return result;
+    }
+    
+    /* Supply may be cut during system sleep, rebuild panel state on wake */
+    mutex_lock(&device_ctx->bus_lock);
+    device_ctx->panel_needs_reinit = true;
+    mutex_unlock(&device_ctx->bus_lock);
+    
+    return 0;
+}
+
+/**
+ * @brief System resume: wake the panel if it was in use and send pending frames
+ * @param dev Pointer to I2C client device
+ * @return 0 on success, negative error code on failure
+ */
+static int __maybe_unused ssd1306_system_resume(struct device *dev)
+{
+    struct ssd1306_device_context *device_ctx = dev_get_drvdata(dev);
+    int result;
+    
+    result = pm_runtime_force_resume(dev);
+    if (result) {
+        return result;
+    }
+    
+    /* Writes that arrived while frozen are still dirty in the shadow */
+    queue_work(device_ctx->flush_workqueue, &device_ctx->flush_work);
+    
+    return 0;
+}
+
+static const struct dev_pm_ops ssd1306_pm_operations = {
+    SET_SYSTEM_SLEEP_PM_OPS(ssd1306_system_suspend, ssd1306_system_resume)
+    SET_RUNTIME_PM_OPS(ssd1306_runtime_suspend, ssd1306_runtime_resume, NULL)
+};
+
+/**
+ * @brief Show the duration of the latest panel wake-up
+ */
+static ssize_t wake_latency_us_show(struct device *dev, struct device_attribute *attr, 
+                                    char *buf)
+{
+    struct ssd1306_device_context *device_ctx = dev_get_drvdata(dev);
+    s64 latency_us;
+    
+    down_read(&device_ctx->display_lock);
+    latency_us = ktime_to_us(device_ctx->last_wake_latency);
+    up_read(&device_ctx->display_lock);
+    
+    return scnprintf(buf, PAGE_SIZE, "%lld\n", latency_us);
+}
+static DEVICE_ATTR_RO(wake_latency_us);
+
+/**
+ * @brief Show the longest panel wake-up since probe
+ */
+static ssize_t max_wake_latency_us_show(struct device *dev, struct device_attribute *attr, 
+                                        char *buf)
+{
+    struct ssd1306_device_context *device_ctx = dev_get_drvdata(dev);
+    s64 latency_us;
+    
+    down_read(&device_ctx->display_lock);
+    latency_us = ktime_to_us(device_ctx->max_wake_latency);
+    up_read(&device_ctx->display_lock);
+    
+    return scnprintf(buf, PAGE_SIZE, "%lld\n", latency_us);
+}
+static DEVICE_ATTR_RO(max_wake_latency_us);
+
+/**
+ * @brief Show the number of runtime resumes since probe
+ */
+static ssize_t wake_count_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+    struct ssd1306_device_context *device_ctx = dev_get_drvdata(dev);
+    uint64_t wake_count;
+    
+    down_read(&device_ctx->display_lock);
+    wake_count = device_ctx->wake_count;
+    up_read(&device_ctx->display_lock);
+    
+    return scnprintf(buf, PAGE_SIZE, "%llu\n", wake_count);
+}
+static DEVICE_ATTR_RO(wake_count);
+
+static struct attribute *ssd1306_power_attributes[] = {
+    &dev_attr_wake_latency_us.attr,
+    &dev_attr_max_wake_latency_us.attr,
+    &dev_attr_wake_count.attr,
+    NULL,
+};
+
+static const struct attribute_group ssd1306_power_attribute_group = {
+    .attrs = ssd1306_power_attributes,
+};
+
+/**
+ * @brief debugfs "statistics": bus and frame counters
+ */
+static int ssd1306_statistics_show(struct seq_file *seq, void *unused)
+{
+    struct ssd1306_device_context *device_ctx = seq->private;
+    struct ssd1306_statistics *statistics = &device_ctx->statistics;
+    uint64_t flush_plans[SSD1306_FLUSH_STRATEGY_COUNT];
+    uint64_t frames_flushed;
+    uint64_t coalesced_writes;
+    uint64_t planned_bytes;
+    uint64_t naive_bytes;
+    
+    down_read(&device_ctx->display_lock);
+    frames_flushed = statistics->frames_flushed;
+    coalesced_writes = statistics->coalesced_writes;
+    memcpy(flush_plans, statistics->flush_plans, sizeof(flush_plans));
+    planned_bytes = statistics->planned_bytes;
+    naive_bytes = statistics->naive_bytes;
+    up_read(&device_ctx->display_lock);
+    
+    seq_printf(seq, "i2c_transactions: %lld\n", atomic64_read(&statistics->i2c_transactions));
+    seq_printf(seq, "i2c_bytes_sent: %lld\n", atomic64_read(&statistics->i2c_bytes_sent));
+    seq_printf(seq, "i2c_errors: %lld\n", atomic64_read(&statistics->i2c_errors));
+    seq_printf(seq, "panel_recoveries: %lld\n", atomic64_read(&statistics->panel_recoveries));
+    seq_printf(seq, "frames_submitted: %lld\n", 
+               atomic64_read(&device_ctx->frame_sequence_submitted));
+    seq_printf(seq, "frames_flushed: %llu\n", frames_flushed);
+    seq_printf(seq, "coalesced_writes: %llu\n", coalesced_writes);
+    seq_printf(seq, "flush_plans_page_addressing: %llu\n", 
+               flush_plans[SSD1306_FLUSH_PAGE_ADDRESSING]);
+    seq_printf(seq, "flush_plans_window: %llu\n", flush_plans[SSD1306_FLUSH_WINDOW]);
+    seq_printf(seq, "planned_bytes: %llu\n", planned_bytes);
+    seq_printf(seq, "naive_bytes: %llu\n", naive_bytes);
+    
+    return 0;
+}
+DEFINE_SHOW_ATTRIBUTE(ssd1306_statistics);
+
+/**
+ * @brief Print one log2 histogram, one "lower_us upper_us count" row per bucket
+ * @param seq Output file
+ * @param title Histogram name
+ * @param histogram Snapshot of the buckets
+ */
+static void ssd1306_print_latency_histogram(struct seq_file *seq, const char *title, 
+                                            const uint32_t *histogram)
+{
+    unsigned int bucket_index;
+    
+    seq_printf(seq, "%s:\n", title);
+    for (bucket_index = 0; bucket_index < SSD1306_LATENCY_BUCKETS; bucket_index++) {
+        unsigned long lower_us = bucket_index ? 1UL << (bucket_index - 1) : 0;
+        
+        if (bucket_index == SSD1306_LATENCY_BUCKETS - 1) {
+            seq_printf(seq, "  %8lu      inf %u\n", lower_us, histogram[bucket_index]);
+        } else {
+            seq_printf(seq, "  %8lu %8lu %u\n", lower_us, 1UL << bucket_index, 
+                       histogram[bucket_index]);
+        }
+    }
+}
+
+/**
+ * @brief debugfs "latency_histograms": write-to-visible and bus time per flush
+ */
+static int ssd1306_latency_histograms_show(struct seq_file *seq, void *unused)
+{
+    struct ssd1306_device_context *device_ctx = seq->private;
+    uint32_t write_latency_histogram[SSD1306_LATENCY_BUCKETS];
+    uint32_t flush_latency_histogram[SSD1306_LATENCY_BUCKETS];
+    
+    down_read(&device_ctx->display_lock);
+    memcpy(write_latency_histogram, device_ctx->statistics.write_latency_histogram, 
+           sizeof(write_latency_histogram));
+    memcpy(flush_latency_histogram, device_ctx->statistics.flush_latency_histogram, 
+           sizeof(flush_latency_histogram));
+    up_read(&device_ctx->display_lock);
+    
+    ssd1306_print_latency_histogram(seq, "write_to_visible_us", write_latency_histogram);
+    ssd1306_print_latency_histogram(seq, "flush_bus_time_us", flush_latency_histogram);
+    
+    return 0;
+}
+DEFINE_SHOW_ATTRIBUTE(ssd1306_latency_histograms);
+
+/**
+ * @brief devm action: remove the per-panel debugfs directory
+ * @param data Pointer to device context
+ */
+static void ssd1306_remove_debugfs(void *data)
+{
+    struct ssd1306_device_context *device_ctx = data;
+    
+    debugfs_remove_recursive(device_ctx->debugfs_directory);
+}
+
+/**
+ * @brief Create <debugfs>/ssd1306/<i2c device>/ with the statistics files
+ * @param device_ctx Pointer to device context
+ * @return 0 on success, negative error code on failure
+ *
+ * debugfs failures are not fatal, the files are simply missing.
+ */
+static int ssd1306_create_debugfs(struct ssd1306_device_context *device_ctx)
+{
+    struct device *dev = &device_ctx->i2c_client_ptr->dev;
+    
+    device_ctx->debugfs_directory = debugfs_create_dir(dev_name(dev), ssd1306_debugfs_root);
+    debugfs_create_file("statistics", 0444, device_ctx->debugfs_directory, 
+                        device_ctx, &ssd1306_statistics_fops);
+    debugfs_create_file("latency_histograms", 0444, device_ctx->debugfs_directory, 
+                        device_ctx, &ssd1306_latency_histograms_fops);
+    
+    return devm_add_action_or_reset(dev, ssd1306_remove_debugfs, device_ctx);
+}
+
+/**
+ * @brief devm action: stop runtime PM before the context goes away
+ * @param data Pointer to device context
+ */
+static void ssd1306_disable_runtime_pm(void *data)
+{
+    struct ssd1306_device_context *device_ctx = data;
+    struct device *dev = &device_ctx->i2c_client_ptr->dev;
+    
+    pm_runtime_dont_use_autosuspend(dev);
+    pm_runtime_disable(dev);
+    pm_runtime_set_suspended(dev);
+}
+
+/**
+ * @brief Create character device file node
+ * @param device_ctx Pointer to device context
+ * @return 0 on success, negative error code on failure
+ *
+ * Each panel gets its own minor in the region reserved at module load
+ * and shows up as /dev/ssd1306-N in the shared class.
+ */
+static int ssd1306_create_character_device(struct ssd1306_device_context *device_ctx)
+{
+    int result = 0;
+    
+    dev_info(&device_ctx->i2c_client_ptr->dev, 
+             "Creating SSD1306 character device\n");
+    
+    /* Pick the lowest free panel index */
+    device_ctx->panel_index = ida_alloc_max(&ssd1306_panel_ida, SSD1306_MAX_PANELS - 1, 
+                                            GFP_KERNEL);
+    if (device_ctx->panel_index < 0) {
+        result = device_ctx->panel_index;
+        dev_err(&device_ctx->i2c_client_ptr->dev, 
+                "No free panel index (max %d panels): %d\n", SSD1306_MAX_PANELS, result);
+        goto allocation_failed;
+    }
+    
+    device_ctx->char_device_number = MKDEV(MAJOR(ssd1306_device_number_base), 
+                                           MINOR(ssd1306_device_number_base) + 
+                                           device_ctx->panel_index);
+    
+    device_ctx->char_device.devt = device_ctx->char_device_number;
+    device_ctx->char_device.class = ssd1306_device_class;
+    device_ctx->char_device.parent = &device_ctx->i2c_client_ptr->dev;
+    dev_set_drvdata(&device_ctx->char_device, device_ctx);
+    result = dev_set_name(&device_ctx->char_device, DEVICE_NAME "-%d", device_ctx->panel_index);
+    if (result) {
+        goto device_creation_failed;
+    }
+    
+    /* The cdev pins char_device, and with it this context, while files are open */
+    cdev_init(&device_ctx->char_device_cdev, &ssd1306_char_device_file_operations);
+    device_ctx->char_device_cdev.owner = THIS_MODULE;
+    
+    result = cdev_device_add(&device_ctx->char_device_cdev, &device_ctx->char_device);
+    if (result) {
+        dev_err(&device_ctx->i2c_client_ptr->dev, 
+                "Failed to add character device: %d\n", result);
+        goto device_creation_failed;
+    }
+    
+    dev_info(&device_ctx->i2c_client_ptr->dev, 
+             "Character device created successfully: /dev/%s-%d (major=%d, minor=%d)\n", 
+             DEVICE_NAME, device_ctx->panel_index, 
+             MAJOR(device_ctx->char_device_number), 
+             MINOR(device_ctx->char_device_number));
+    return 0;
+    
+    /* Error cleanup */
+device_creation_failed:
+    ida_free(&ssd1306_panel_ida, device_ctx->panel_index);
+allocation_failed:
+    return result;
+}
+
+/**
+ * @brief Destroy character device file node
+ * @param device_ctx Pointer to device context
+ *
+ * Files still open keep the context alive but fail from here on, and
+ * pollers are woken to see EPOLLHUP.
+ */
+static void ssd1306_destroy_character_device(struct ssd1306_device_context *device_ctx)
+{
+    down_write(&device_ctx->removal_lock);
+    device_ctx->is_removed = true;
+    up_write(&device_ctx->removal_lock);
+    wake_up_interruptible(&device_ctx->frame_wait_queue);
+    
+    cdev_device_del(&device_ctx->char_device_cdev, &device_ctx->char_device);
+    ida_free(&ssd1306_panel_ida, device_ctx->panel_index);
+}
+
+/**
+ * @brief Release callback of char_device, frees the context
+ * @param dev Character device embedded in the context
+ *
+ * Runs after remove once the last open file is closed.
+ */
+static void ssd1306_release_device_context(struct device *dev)
+{
+    struct ssd1306_device_context *device_ctx = 
+        container_of(dev, struct ssd1306_device_context, char_device);
+    
+    vfree(device_ctx->mmap_framebuffer);
+    kfree(device_ctx);
+}
+
+/**
+ * @brief devm action dropping the driver's reference to the context
+ * @param data Pointer to device context
+ *
+ * Registered first, so it runs after every other devm action of the
+ * panel has stopped using the context.
+ */
+static void ssd1306_put_device_context(void *data)
+{
+    struct ssd1306_device_context *device_ctx = data;
+    
+    put_device(&device_ctx->char_device);
+}
+
+/**
+ * @brief devm action releasing the flush workqueue
+ * @param data Pointer to device context
+ */
+static void ssd1306_destroy_flush_workqueue(void *data)
+{
+    struct ssd1306_device_context *device_ctx = data;
+    
+    /* A last failing flush may still arm the recovery timer */
+    flush_workqueue(device_ctx->flush_workqueue);
+    cancel_delayed_work_sync(&device_ctx->recovery_work);
+    destroy_workqueue(device_ctx->flush_workqueue);
+}
+
+/**
+ * @brief I2C probe callback function
  * @param client Pointer to I2C client structure
  * @param device_id Pointer to I2C device ID structure
  * @return 0 on success, negative error code on failure
@@ -569,44 +4309,148 @@ static int ssd1306_i2c_probe_callback(struct i2c_client *client,
                                       const struct i2c_device_id *device_id)
 {
     struct ssd1306_device_context *device_ctx;
+    int page_index;
     int result;
     
     dev_info(&client->dev, "SSD1306 I2C probe started\n");
     
-    /* Allocate device context structure */
-    device_ctx = devm_kzalloc(&client->dev, sizeof(*device_ctx), GFP_KERNEL);
+    /* Allocate device context structure, it may outlive the I2C client */
+    device_ctx = kzalloc(sizeof(*device_ctx), GFP_KERNEL);
     if (!device_ctx) {
         dev_err(&client->dev, "Failed to allocate device context memory\n");
         return -ENOMEM;
     }
     
+    device_initialize(&device_ctx->char_device);
+    device_ctx->char_device.release = ssd1306_release_device_context;
+    
+    result = devm_add_action_or_reset(&client->dev, ssd1306_put_device_context, device_ctx);
+    if (result) {
+        return result;
+    }
+    
     /* Initialize device context */
     device_ctx->i2c_client_ptr = client;
+    init_rwsem(&device_ctx->removal_lock);
+    init_rwsem(&device_ctx->display_lock);
+    for (page_index = 0; page_index < DISPLAY_TOTAL_PAGES; page_index++) {
+        mutex_init(&device_ctx->page_row_locks[page_index]);
+    }
+    mutex_init(&device_ctx->bus_lock);
+    INIT_WORK(&device_ctx->flush_work, ssd1306_flush_work_handler);
+    INIT_WORK(&device_ctx->bringup_work, ssd1306_bringup_work_handler);
+    INIT_DELAYED_WORK(&device_ctx->recovery_work, ssd1306_recovery_work_handler);
+    device_ctx->recovery_delay_ms = SSD1306_RECOVERY_INITIAL_DELAY_MS;
+    init_waitqueue_head(&device_ctx->frame_wait_queue);
     i2c_set_clientdata(client, device_ctx);
     
-    /* Initialize display hardware */
-    result = ssd1306_initialize_display_hardware(device_ctx);
+    /* Panel size decides the init sequence and every transfer window */
+    result = ssd1306_read_panel_geometry(device_ctx);
+    if (result) {
+        return result;
+    }
+    
+    /* Bulk transfer buffer, devm frees it after the workqueue below is drained */
+    result = ssd1306_setup_i2c_transfer_buffer(device_ctx);
+    if (result) {
+        dev_err(&client->dev, "Failed to set up I2C transfer buffer: %d\n", result);
+        return result;
+    }
+    
+    /* Dedicated ordered workqueue keeps bus traffic off writer threads */
+    device_ctx->flush_workqueue = alloc_ordered_workqueue("ssd1306-flush-%s", WQ_FREEZABLE, 
+                                                          dev_name(&client->dev));
+    if (!device_ctx->flush_workqueue) {
+        return -ENOMEM;
+    }
+    
+    result = devm_add_action_or_reset(&client->dev, ssd1306_destroy_flush_workqueue, device_ctx);
+    if (result) {
+        return result;
+    }
+    
+    device_ctx->pm_notifier.notifier_call = ssd1306_pm_notifier_callback;
+    result = register_pm_notifier(&device_ctx->pm_notifier);
+    if (result) {
+        return result;
+    }
+    
+    result = devm_add_action_or_reset(&client->dev, ssd1306_unregister_pm_notifier, device_ctx);
+    if (result) {
+        return result;
+    }
+    
+    /* Blank shadow now, the panel is initialized by the bring-up worker */
+    ssd1306_reset_display_state(device_ctx);
+    
+    /* Panel starts suspended, the first access resumes it through the full init */
+    pm_runtime_set_autosuspend_delay(&client->dev, autosuspend_delay_ms);
+    pm_runtime_use_autosuspend(&client->dev);
+    pm_runtime_enable(&client->dev);
+    
+    result = devm_add_action_or_reset(&client->dev, ssd1306_disable_runtime_pm, device_ctx);
+    if (result) {
+        return result;
+    }
+    
+    result = devm_device_add_group(&client->dev, &ssd1306_power_attribute_group);
+    if (result) {
+        return result;
+    }
+    
+    result = ssd1306_create_debugfs(device_ctx);
     if (result) {
-        dev_err(&client->dev, "Failed to initialize display hardware: %d\n", result);
         return result;
     }
     
-    /* Set cursor and display demo message */
-    ssd1306_set_cursor_position(device_ctx, 0, 0);
-    ssd1306_write_text_to_display(device_ctx, "HELLO SON TUNG\nSSD1306 Ready");
+    /* Demo message goes out with the first frame */
+    if (show_banners) {
+        ssd1306_draw_text_to_shadow(device_ctx, "HELLO SON TUNG\nSSD1306 Ready");
+    }
+    
+    /* Allocate page-aligned framebuffer for userspace mapping */
+    device_ctx->mmap_framebuffer = vmalloc_user(PAGE_ALIGN(SSD1306_FB_SIZE));
+    if (!device_ctx->mmap_framebuffer) {
+        return -ENOMEM;
+    }
+    
+    /* Queued ahead of any flush; writes before it completes wait in the shadow */
+    queue_work(device_ctx->flush_workqueue, &device_ctx->bringup_work);
     
     /* Create character device */
     result = ssd1306_create_character_device(device_ctx);
     if (result) {
         dev_err(&client->dev, "Failed to create character device: %d\n", result);
-        return result;
+        goto character_device_creation_failed;
+    }
+    
+    /* Register framebuffer device for graphics clients */
+    result = ssd1306_register_framebuffer(device_ctx);
+    if (result) {
+        goto framebuffer_registration_failed;
     }
     
-    /* Set global device instance */
-    global_ssd1306_device = device_ctx;
+    /* Register DRM/KMS front end for compositors */
+    result = ssd1306_register_drm_device(device_ctx);
+    if (result) {
+        dev_err(&client->dev, "Failed to register DRM device: %d\n", result);
+        goto drm_registration_failed;
+    }
     
     dev_info(&client->dev, "SSD1306 probe completed successfully\n");
     return 0;
+    
+    /* Error cleanup */
+drm_registration_failed:
+    ssd1306_unregister_framebuffer(device_ctx);
+framebuffer_registration_failed:
+    ssd1306_destroy_character_device(device_ctx);
+character_device_creation_failed:
+    /* Writers may have queued frames while the interfaces were live */
+    cancel_work_sync(&device_ctx->bringup_work);
+    cancel_work_sync(&device_ctx->flush_work);
+    cancel_delayed_work_sync(&device_ctx->recovery_work);
+    return result;
 }
 
 /**
@@ -620,35 +4464,103 @@ static int ssd1306_i2c_remove_callback(struct i2c_client *client)
     
     dev_info(&client->dev, "SSD1306 I2C remove started\n");
     
-    /* Display goodbye message */
-    ssd1306_write_text_to_display(device_ctx, "GOODBYE!\nShutdown...");
-    msleep(1000);
+    /* Keep the panel awake for the final frames */
+    pm_runtime_get_sync(&client->dev);
+    
+    /* Stop graphics clients before the panel goes dark */
+    ssd1306_unregister_drm_device(device_ctx);
+    ssd1306_unregister_framebuffer(device_ctx);
+    
+    /* Clean up character device */
+    ssd1306_destroy_character_device(device_ctx);
+    
+    /* Show whatever is still in the back buffer, then draw directly */
+    down_write(&device_ctx->display_lock);
+    ssd1306_set_double_buffered(device_ctx, false);
+    up_write(&device_ctx->display_lock);
+    
+    /* Let queued flushes finish before the final frames */
+    flush_workqueue(device_ctx->flush_workqueue);
+    
+    /* Optional goodbye message, held only when asked for */
+    if (show_banners) {
+        ssd1306_write_text_to_display(device_ctx, "GOODBYE!\nShutdown...");
+        msleep(SSD1306_GOODBYE_HOLD_MS);
+    }
     
     /* Clear display and turn off */
     ssd1306_clear_display_screen(device_ctx);
+    mutex_lock(&device_ctx->bus_lock);
     ssd1306_send_i2c_command(device_ctx, SSD1306_CMD_DISPLAY_OFF);
+    mutex_unlock(&device_ctx->bus_lock);
     
-    /* Clean up character device */
-    cdev_del(&device_ctx->char_device_cdev);
-    device_destroy(device_ctx->char_device_class, device_ctx->char_device_number);
-    class_destroy(device_ctx->char_device_class);
-    unregister_chrdev_region(device_ctx->char_device_number, 1);
+    /* Nothing left worth restoring */
+    cancel_delayed_work_sync(&device_ctx->recovery_work);
+    
+    down_write(&device_ctx->display_lock);
+    ssd1306_keep_panel_awake(device_ctx, &device_ctx->ticker_holds_panel, false);
+    up_write(&device_ctx->display_lock);
     
-    /* Clear global reference */
-    global_ssd1306_device = NULL;
+    pm_runtime_put_noidle(&client->dev);
     
     dev_info(&client->dev, "SSD1306 I2C remove completed\n");
     return 0;
 }
 
 /**
- * @brief Register I2C driver using modern macro
- * 
- * module_i2c_driver() automatically generates:
- * - module_init() function that calls i2c_add_driver()
- * - module_exit() function that calls i2c_del_driver()
+ * @brief Module init: reserve minors and the class shared by all panels
+ * @return 0 on success, negative error code on failure
+ */
+static int __init ssd1306_driver_init(void)
+{
+    int result;
+    
+    result = alloc_chrdev_region(&ssd1306_device_number_base, 0, SSD1306_MAX_PANELS, 
+                                 DEVICE_NAME);
+    if (result < 0) {
+        pr_err("ssd1306: Failed to allocate character device region: %d\n", result);
+        return result;
+    }
+    
+    ssd1306_device_class = class_create(THIS_MODULE, DEVICE_CLASS_NAME);
+    if (IS_ERR(ssd1306_device_class)) {
+        result = PTR_ERR(ssd1306_device_class);
+        pr_err("ssd1306: Failed to create device class: %d\n", result);
+        goto class_creation_failed;
+    }
+    
+    ssd1306_debugfs_root = debugfs_create_dir(DEVICE_NAME, NULL);
+    
+    result = i2c_add_driver(&ssd1306_i2c_driver_instance);
+    if (result) {
+        goto driver_registration_failed;
+    }
+    
+    return 0;
+    
+    /* Error cleanup */
+driver_registration_failed:
+    debugfs_remove_recursive(ssd1306_debugfs_root);
+    class_destroy(ssd1306_device_class);
+class_creation_failed:
+    unregister_chrdev_region(ssd1306_device_number_base, SSD1306_MAX_PANELS);
+    return result;
+}
+
+/**
+ * @brief Module exit: all panels are removed before the class goes away
  */
-module_i2c_driver(ssd1306_i2c_driver_instance);
+static void __exit ssd1306_driver_exit(void)
+{
+    i2c_del_driver(&ssd1306_i2c_driver_instance);
+    debugfs_remove_recursive(ssd1306_debugfs_root);
+    class_destroy(ssd1306_device_class);
+    unregister_chrdev_region(ssd1306_device_number_base, SSD1306_MAX_PANELS);
+    ida_destroy(&ssd1306_panel_ida);
+}
+
+module_init(ssd1306_driver_init);
+module_exit(ssd1306_driver_exit);
 
 MODULE_LICENSE("GPL");
 MODULE_AUTHOR("TungNHS");
@@ -13,31 +13,172 @@
 
 #include <linux/i2c.h>
 #include <linux/cdev.h>
+#include <linux/mutex.h>
+#include <linux/notifier.h>
+#include <linux/rwsem.h>
+#include <linux/workqueue.h>
+#include <linux/wait.h>
+#include <linux/ktime.h>
 
-/* Display hardware constant */
+#include "ssd1306_ioctl.h"
+
+/* Display hardware constant (controller GDDRAM, largest supported panel) */
 #define DISPLAY_WIDTH_PIXELS        128    /* Display width in pixels */
 #define DISPLAY_HEIGHT_PIXELS       64     /* Display height in pixels */
 #define DISPLAY_TOTAL_PAGES         8      /* Total pages (64/8 = 8) */
 #define FONT_CHAR_WIDTH             6      /* Character width (5 + 1 space) */
+#define FONT_FIRST_CHAR             0x20   /* First glyph in font atlas (space) */
+#define FONT_GLYPH_COUNT            95     /* Printable ASCII 0x20-0x7E */
 #define MAX_CHARS_PER_LINE          21     /* Max characters per line (128/6) */
 #define MAX_DISPLAY_LINES           8      /* Maximum display lines */
 #define MAX_MESSAGE_BUFFER_SIZE     256    /* Message buffer size */
+#define FBDEV_DEFAULT_REFRESH_RATE  10     /* Deferred I/O flushes per second */
+#define SSD1306_DEFAULT_AUTOSUSPEND_MS -1  /* Idle power-off is opt-in */
+#define SSD1306_LATENCY_BUCKETS     21     /* log2 microsecond buckets, last one open-ended */
+#define SSD1306_RECOVERY_INITIAL_DELAY_MS 50    /* First re-init attempt after a bus error */
+#define SSD1306_RECOVERY_MAX_DELAY_MS     10000 /* Backoff ceiling between attempts */
+#define SSD1306_RECOVERY_MAX_ATTEMPTS     10    /* Failed re-inits before waiting for the next flush */
+#define SSD1306_POWER_ON_DELAY_MS   100    /* Supply settle time before the first command */
+#define SSD1306_GOODBYE_HOLD_MS     1000   /* Time the optional goodbye banner stays up */
 
 /* Device naming constants */
 #define DEVICE_NAME                 "ssd1306"
 #define DEVICE_CLASS_NAME           "ssd1306_class"
+#define SSD1306_MAX_PANELS          16     /* Minors reserved for /dev/ssd1306-N */
 #define I2C_DRIVER_NAME             "ssd1306-i2c"
 
 /* I2C communication constants */
 #define I2C_CMD_PREFIX              0x00    /* Command prefix */
 #define I2C_DATA_PREFIX             0x40    /* Data prefix */
+#define SSD1306_MAX_COMMAND_LIST_SIZE 32     /* Max queued command bytes */
+#define I2C_MESSAGE_OVERHEAD        2       /* Address and control byte of every message */
+#define I2C_MAX_TRANSFER_SIZE       (DISPLAY_WIDTH_PIXELS * DISPLAY_TOTAL_PAGES + 1) /* Full frame + prefix */
 
 /* SSD1306 command definitions */
 #define SSD1306_CMD_DISPLAY_OFF     0xAE   /* Display OFF */
 #define SSD1306_CMD_DISPLAY_ON      0xAF   /* Display ON */
 #define SSD1306_CMD_SET_CONTRAST    0x81   /* Set contrast */
+#define SSD1306_CMD_NORMAL_DISPLAY  0xA6   /* Lit pixel = 1 */
+#define SSD1306_CMD_INVERT_DISPLAY  0xA7   /* Lit pixel = 0 */
 #define SSD1306_CMD_SET_COLUMN_ADDR 0x21   /* Set column address */
 #define SSD1306_CMD_SET_PAGE_ADDR   0x22   /* Set page address */
+#define SSD1306_CMD_SET_ADDRESSING_MODE 0x20 /* Memory addressing mode */
+#define SSD1306_ADDRESSING_HORIZONTAL 0x00
+#define SSD1306_ADDRESSING_PAGE     0x02
+#define SSD1306_CMD_SET_PAGE_START  0xB0   /* Page addressing: page (OR 0-7) */
+#define SSD1306_CMD_SET_LOW_COLUMN  0x00   /* Page addressing: column low nibble */
+#define SSD1306_CMD_SET_HIGH_COLUMN 0x10   /* Page addressing: column high nibble */
+#define SSD1306_CMD_SET_START_LINE  0x40   /* Set display start line (OR 0-63) */
+#define SSD1306_CMD_CHARGE_PUMP     0x8D   /* Charge pump setting */
+#define SSD1306_CHARGE_PUMP_ENABLE  0x14
+#define SSD1306_CHARGE_PUMP_DISABLE 0x10
+#define SSD1306_CMD_SCROLL_RIGHT    0x26   /* Continuous right horizontal scroll setup */
+#define SSD1306_CMD_SCROLL_LEFT     0x27   /* Continuous left horizontal scroll setup */
+#define SSD1306_CMD_SCROLL_STOP     0x2E   /* Deactivate scroll */
+#define SSD1306_CMD_SCROLL_START    0x2F   /* Activate scroll */
+
+/**
+ * @brief Supported module geometry
+ *
+ * Narrow modules are wired to the middle of the 128-column GDDRAM, and
+ * 64-row glass needs the alternative COM pin layout.
+ */
+struct ssd1306_panel_geometry {
+    uint8_t width;
+    uint8_t height;
+    uint8_t column_offset;               /* First GDDRAM column of the glass */
+    uint8_t com_pins;                    /* Argument of the 0xDA command */
+};
+
+/**
+ * @brief Dirty column range of one display page
+ *
+ * Columns between first_column and last_column (inclusive) differ from
+ * what the panel currently shows and are sent on the next flush.
+ */
+struct ssd1306_dirty_column_range {
+    uint8_t first_column;
+    uint8_t last_column;
+    bool is_dirty;
+};
+
+/**
+ * @brief Queued command bytes sent as one transfer
+ *
+ * The controller accepts a single 0x00 control byte followed by any
+ * number of command and argument bytes.
+ */
+struct ssd1306_command_list {
+    uint8_t command_bytes[SSD1306_MAX_COMMAND_LIST_SIZE];
+    size_t command_count;
+    bool has_overflowed;
+};
+
+/**
+ * @brief How a flush addresses GDDRAM
+ *
+ * PAGE_ADDRESSING positions each dirty span with three page-mode
+ * commands. WINDOW sets one horizontal window around all dirty spans and
+ * streams it in a single burst, resending clean columns inside it.
+ */
+enum ssd1306_flush_strategy {
+    SSD1306_FLUSH_PAGE_ADDRESSING,
+    SSD1306_FLUSH_WINDOW,
+    SSD1306_FLUSH_STRATEGY_COUNT
+};
+
+/**
+ * @brief Cheapest command and data sequence for one flush
+ *
+ * Costs are bytes on the wire, including the address and control byte of
+ * every message. naive_cost is one horizontal window per dirty page.
+ */
+struct ssd1306_flush_plan {
+    enum ssd1306_flush_strategy strategy;
+    size_t cost;
+    size_t naive_cost;
+    uint8_t first_page;                  /* Window bounds, RAM pages and columns */
+    uint8_t last_page;
+    uint8_t first_column;
+    uint8_t last_column;
+};
+
+/**
+ * @brief Dirty regions copied out of the shadow for one flush
+ *
+ * Lets the flush worker drive the bus without holding display_lock.
+ */
+struct ssd1306_flush_snapshot {
+    struct ssd1306_dirty_column_range page_ranges[DISPLAY_TOTAL_PAGES];
+    uint8_t page_data[DISPLAY_TOTAL_PAGES][DISPLAY_WIDTH_PIXELS];
+    uint8_t window_data[DISPLAY_TOTAL_PAGES * DISPLAY_WIDTH_PIXELS];  /* WINDOW burst */
+    struct ssd1306_flush_plan plan;
+    uint64_t frame_sequence;             /* Newest submission included */
+    uint8_t display_start_line;          /* Start line matching page_data */
+    struct ssd1306_ticker ticker;        /* Requested hardware scroll */
+    ktime_t oldest_write_time;           /* First submission not yet visible, 0 if none */
+};
+
+/**
+ * @brief Per-panel counters and latency histograms exported in debugfs
+ *
+ * Bus counters are updated on every transfer; frame counters and
+ * histograms are protected by display_lock. Histogram bucket N counts
+ * latencies in [2^(N-1), 2^N) microseconds, bucket 0 is below 1 us.
+ */
+struct ssd1306_statistics {
+    atomic64_t i2c_transactions;
+    atomic64_t i2c_bytes_sent;           /* Including control bytes */
+    atomic64_t i2c_errors;
+    atomic64_t panel_recoveries;         /* Successful re-inits after bus errors */
+    uint64_t frames_flushed;             /* Flushes that made new writes visible */
+    uint64_t coalesced_writes;           /* Writes merged into another write's flush */
+    uint64_t flush_plans[SSD1306_FLUSH_STRATEGY_COUNT];  /* Flushes per addressing strategy */
+    uint64_t planned_bytes;              /* Wire bytes of the chosen plans */
+    uint64_t naive_bytes;                /* Same flushes with one window per page */
+    uint32_t write_latency_histogram[SSD1306_LATENCY_BUCKETS];   /* Write to visible */
+    uint32_t flush_latency_histogram[SSD1306_LATENCY_BUCKETS];   /* Bus time per flush */
+};
 
 /**
  * @brief Main driver context structure
@@ -47,27 +188,135 @@
 struct ssd1306_device_context {
     /* I2C communication components */
     struct i2c_client *i2c_client_ptr;
+    uint8_t *i2c_transfer_buffer;        /* Prefix + payload scratch buffer */
+    size_t i2c_max_write_length;         /* Adapter limit incl. prefix byte */
 
-    /* Character device components */
-    struct device *char_device_node;
-    struct class *char_device_class;
+    /*
+     * Character device components (/dev/ssd1306-N, N = panel_index).
+     * char_device owns this context: open files pin it through the cdev
+     * and its release callback frees the context after the last close.
+     */
+    struct device char_device;
     struct cdev char_device_cdev;
     dev_t char_device_number;
+    int panel_index;
+    struct rw_semaphore removal_lock;    /* Held shared by file operations */
+    bool is_removed;                     /* Panel gone, file operations fail with -ENODEV */
+    
+    /* Framebuffer device components (CONFIG_SSD1306_FBDEV) */
+    struct fb_info *framebuffer_info;
+    void *fbdev_video_memory;            /* 1bpp linear, row-major */
+    
+    /* DRM/KMS front end (CONFIG_SSD1306_DRM) */
+    struct drm_device *drm_device_ptr;
+    
+    /* Userspace-mapped page-format framebuffer (/dev/ssd1306-N mmap) */
+    uint8_t *mmap_framebuffer;
+    unsigned int mmap_users;             /* Live mappings, protected by display_lock */
 
-    /* Display state management */
+    /*
+     * Display state management. Whole-screen and global state changes take
+     * display_lock for writing. Region writers (cell writes, mmap rects,
+     * blits) and the flush snapshot take it for reading plus the lock of
+     * each RAM page row they touch, so disjoint rows update in parallel.
+     */
+    struct rw_semaphore display_lock;    /* Protects shadow state, held briefly */
+    struct mutex page_row_locks[DISPLAY_TOTAL_PAGES];  /* Per RAM page under a read-held display_lock */
+    struct mutex bus_lock;               /* Serializes I2C sequences, taken before display_lock */
     uint8_t current_cursor_line;         
     uint8_t current_cursor_column;      
     char message_display_buffer[MAX_MESSAGE_BUFFER_SIZE];   // Display buffer
     
+    /* Character cells drawn by the text path, a line is valid until pixels are drawn on it */
+    char text_cells[MAX_DISPLAY_LINES][MAX_CHARS_PER_LINE];
+    bool text_line_valid[MAX_DISPLAY_LINES];
+    
+    /* Shadow framebuffer in page format (1 byte = 8 vertical pixels) */
+    uint8_t display_framebuffer[DISPLAY_TOTAL_PAGES][DISPLAY_WIDTH_PIXELS];
+    uint8_t compose_framebuffer[DISPLAY_TOTAL_PAGES][DISPLAY_WIDTH_PIXELS];  // Off-screen render target
+    struct ssd1306_dirty_column_range page_dirty_ranges[DISPLAY_TOTAL_PAGES];
+    
+    /* Back buffer (SSD1306_IOCTL_SET_DOUBLE_BUFFER), RAM page order like the shadow */
+    uint8_t back_framebuffer[DISPLAY_TOTAL_PAGES][DISPLAY_WIDTH_PIXELS];
+    struct ssd1306_dirty_column_range back_dirty_ranges[DISPLAY_TOTAL_PAGES];   /* Changed since last flip */
+    bool is_double_buffered;             /* Producers draw into back_framebuffer */
+    
+    /* Hardware text scrolling via the display start line */
+    uint8_t scroll_page_offset;          /* RAM page shown as top row */
+    uint8_t pending_scroll_lines;        /* Compose-buffer scrolls not yet committed */
+    uint8_t panel_start_line;            /* Start line last sent, owned by bus_lock */
+    
+    /* Hardware horizontal scroll (SSD1306_IOCTL_SET_TICKER) */
+    struct ssd1306_ticker ticker_config;         /* Requested, protected by display_lock */
+    bool ticker_holds_panel;             /* Runtime PM reference while a ticker runs */
+    struct ssd1306_ticker panel_ticker;          /* Running on panel, owned by bus_lock */
+    uint8_t panel_ticker_first_page;     /* RAM pages scrolled by panel_ticker */
+    uint8_t panel_ticker_last_page;
+    uint8_t panel_addressing_mode;       /* SSD1306_ADDRESSING_*, owned by bus_lock */
+    
+    /* Asynchronous flush engine */
+    struct workqueue_struct *flush_workqueue;
+    struct work_struct flush_work;
+    struct notifier_block pm_notifier;   /* Drains flush_workqueue before tasks freeze */
+    struct ssd1306_flush_snapshot flush_snapshot;    /* Owned by bus_lock holder */
+    
+    /* Frame completion tracking (poll / SSD1306_IOCTL_GET_FRAME_INFO) */
+    atomic64_t frame_sequence_submitted;
+    uint64_t frame_sequence_completed;   /* Protected by display_lock */
+    ktime_t frame_completed_time;        /* CLOCK_MONOTONIC of last completion */
+    int last_flush_result;
+    wait_queue_head_t frame_wait_queue;
+    atomic64_t oldest_pending_write;     /* ktime of first unflushed submission, 0 if none */
+    
+    /* Statistics (debugfs <root>/ssd1306/<i2c device>/) */
+    struct ssd1306_statistics statistics;
+    struct dentry *debugfs_directory;
+    
+    /* Runtime PM, wake statistics protected by display_lock */
+    bool panel_needs_reinit;             /* Panel state unknown (sleep, bus error), owned by bus_lock */
+    ktime_t last_wake_latency;           /* Duration of the latest runtime resume */
+    ktime_t max_wake_latency;
+    uint64_t wake_count;
+    
+    /* First panel init after probe, runs on flush_workqueue ahead of any flush */
+    struct work_struct bringup_work;
+    
+    /* Background re-init after transfer errors, runs on flush_workqueue */
+    struct delayed_work recovery_work;
+    unsigned int recovery_delay_ms;      /* Next retry delay, owned by bus_lock */
+    unsigned int recovery_attempts;      /* Failed re-inits in this round, owned by bus_lock */
+    
+    /* Panel geometry from the device tree width/height properties */
+    uint8_t panel_width;                 /* Visible columns */
+    uint8_t panel_height;                /* Visible rows */
+    uint8_t panel_pages;                 /* Visible page rows */
+    uint8_t panel_column_offset;         /* First GDDRAM column wired to the glass */
+    uint8_t panel_com_pins;              /* COM pins configuration (0xDA) */
+    uint8_t text_columns;                /* Character cells per text line */
+    uint8_t unsynced_page_mask;          /* RAM pages not written since init */
+    
     /* Device configuration */  
     bool is_display_enabled;
+    bool is_display_inverted;
     uint8_t display_brightness_level;
 };
 
+/**
+ * @brief Per-open file state for /dev/ssd1306-N
+ */
+struct ssd1306_file_context {
+    struct ssd1306_device_context *device_ctx;
+    uint64_t submitted_frame_sequence;   /* Last frame this file queued */
+    uint32_t write_mode;                 /* SSD1306_WRITE_MODE_* */
+};
+
 /* Function prototype */
 int ssd1306_initialize_display_hardware(struct ssd1306_device_context *device_ctx);
 int ssd1306_clear_display_screen(struct ssd1306_device_context *device_ctx);
 int ssd1306_write_text_to_display(struct ssd1306_device_context *device_ctx, const char *text_string);
 int ssd1306_set_display_brightness(struct ssd1306_device_context *device_ctx, uint8_t brightness_level);
+int ssd1306_set_display_inverted(struct ssd1306_device_context *device_ctx, bool invert_display);
+int ssd1306_set_display_power(struct ssd1306_device_context *device_ctx, bool enable_display);
+int ssd1306_flush_framebuffer(struct ssd1306_device_context *device_ctx);
 
 #endif /* SSD1306_DRIVER_H */
\ No newline at end of file
@@ -0,0 +1,228 @@
+/**
+ * @file ssd1306_ioctl.h
+ * @brief SSD1306 OLED Display Driver Userspace Interface
+ * @author TungNHS
+ * @version 1.0
+ * 
+ * ioctl definitions shared between the kernel driver and userspace
+ * applications using /dev/ssd1306-N
+ */
+
+#ifndef SSD1306_IOCTL_H
+#define SSD1306_IOCTL_H
+
+#include <linux/ioctl.h>
+#include <linux/types.h>
+
+/*
+ * Memory-mapped framebuffer layout (page format). Sized for the largest
+ * panel; smaller panels (device tree width/height) use the top-left
+ * width x height/8 bytes and reject rectangles outside them.
+ */
+#define SSD1306_FB_WIDTH            128    /* Bytes per page row */
+#define SSD1306_FB_PAGES            8      /* Page rows (8 pixels each) */
+#define SSD1306_FB_SIZE             (SSD1306_FB_WIDTH * SSD1306_FB_PAGES)
+
+/*
+ * Text cell grid, file offset = line * SSD1306_TEXT_COLUMNS + column.
+ * Smaller panels show width/6 columns and height/8 lines of it.
+ */
+#define SSD1306_TEXT_COLUMNS        21     /* 6-pixel character cells per line */
+#define SSD1306_TEXT_LINES          8      /* One text line per page row */
+#define SSD1306_TEXT_CELLS          (SSD1306_TEXT_COLUMNS * SSD1306_TEXT_LINES)
+
+/* Request limits */
+#define SSD1306_MAX_FLUSH_RECTS     16     /* Max rectangles per flush */
+#define SSD1306_MAX_BATCH_OPS       32     /* Max operations per batch */
+#define SSD1306_MAX_FRAME_STREAM    (SSD1306_FB_SIZE + SSD1306_FB_SIZE / 128) /* Worst-case encoded frame */
+
+/* Version of this interface, bumped when ioctls or structures change */
+#define SSD1306_IOCTL_API_VERSION   3
+
+/**
+ * @brief Rectangle in pixel coordinates
+ *
+ * Rows are widened to whole 8-pixel pages when flushed.
+ */
+struct ssd1306_rect {
+    __u16 x;
+    __u16 y;
+    __u16 width;
+    __u16 height;
+};
+
+/**
+ * @brief FLUSH request
+ *
+ * Queues the mmap'ed framebuffer for the panel. With rect_count == 0 the
+ * whole frame is compared, otherwise only the listed rectangles. Either
+ * way only bytes that differ from the panel content are sent.
+ */
+struct ssd1306_flush_request {
+    __u32 rect_count;                       /* Entries at rects_ptr, 0 = full frame */
+    __u32 reserved;                         /* Must be zero */
+    __u64 rects_ptr;                        /* Userspace struct ssd1306_rect array */
+};
+
+/**
+ * @brief Frame completion status
+ *
+ * Every write() or FLUSH is assigned a sequence number; a frame is
+ * complete once its content has been sent to the panel. poll() reports
+ * POLLOUT when submitted_sequence <= completed_sequence, and POLLERR
+ * while last_flush_error is non-zero.
+ */
+struct ssd1306_frame_info {
+    __u64 submitted_sequence;               /* Last frame queued by this fd */
+    __u64 completed_sequence;               /* Newest frame visible on panel */
+    __u64 completed_timestamp_ns;           /* CLOCK_MONOTONIC of completion */
+    __s32 last_flush_error;                 /* 0 or negative errno */
+    __u32 reserved;
+};
+
+/* Ticker scroll directions */
+#define SSD1306_TICKER_OFF          0
+#define SSD1306_TICKER_RIGHT        1
+#define SSD1306_TICKER_LEFT         2
+
+/**
+ * @brief Hardware horizontal scroll (ticker) configuration
+ *
+ * Rotates the page rows first_page..last_page (0 = top) by one column
+ * every frame_interval panel frames, entirely inside the controller.
+ * Valid intervals are 2, 3, 4, 5, 25, 64, 128 and 256 frames. Any
+ * update to the panel briefly stops the ticker so RAM can be rewritten,
+ * which restarts the scrolled rows from their framebuffer content.
+ */
+struct ssd1306_ticker {
+    __u32 direction;                        /* SSD1306_TICKER_* */
+    __u32 first_page;                       /* First scrolled page row */
+    __u32 last_page;                        /* Last scrolled page row, inclusive */
+    __u32 frame_interval;                   /* Frames per one-column step */
+};
+
+/*
+ * Write modes (SSD1306_IOCTL_SET_WRITE_MODE, per open file)
+ *
+ * SCREEN: each write() replaces the whole text screen (default).
+ * CELLS:  the file offset is a cell index; write()/pwrite() overwrite
+ *         cells in place from there and read() returns the cell grid,
+ *         so independent processes can each own a region of the screen.
+ *         '\n' moves to the next line; every other control character
+ *         and NUL is not skipped but drawn as a blank cell (read back
+ *         as ' ').
+ *
+ * Binary frame modes (API version 2): each write() carries exactly one
+ * encoded frame of width x height/8 bytes in page format, top page row
+ * first, for the panel geometry. The stream is a sequence of runs:
+ *
+ *   0x00-0x7F  n: (n & 0x7F) + 1 literal bytes follow
+ *   0x80-0xFF  n: the next byte repeated (n & 0x7F) + 1 times
+ *
+ * FRAME_RLE:   the decoded bytes replace the frame.
+ * FRAME_DELTA: the decoded bytes are XORed into the frame on screen, so
+ *              unchanged areas are runs of zero and cost nothing.
+ *
+ * A stream that does not decode to exactly one frame is rejected with
+ * EINVAL and leaves the screen untouched.
+ */
+#define SSD1306_WRITE_MODE_SCREEN       0
+#define SSD1306_WRITE_MODE_CELLS        1
+#define SSD1306_WRITE_MODE_FRAME_RLE    2
+#define SSD1306_WRITE_MODE_FRAME_DELTA  3
+
+#define SSD1306_FRAME_RUN_REPEAT    0x80   /* Run header flag: repeat next byte */
+#define SSD1306_FRAME_RUN_LENGTH    0x7F   /* Run header mask: length - 1 */
+
+/*
+ * Double buffering (SSD1306_IOCTL_SET_DOUBLE_BUFFER, per panel, API 3)
+ *
+ * While enabled, every producer (text writes, mmap flushes, blits,
+ * frame writes, fbdev/DRM) draws into a back buffer seeded from the
+ * screen, and nothing reaches the panel until SSD1306_IOCTL_FLIP hands
+ * the back buffer to the flush engine in one step. FLIP returns the
+ * frame sequence that GET_FRAME_INFO and poll() report once visible.
+ * Disabling flips any pending content.
+ */
+
+/**
+ * @brief Interface version reported by SSD1306_IOCTL_GET_VERSION
+ */
+struct ssd1306_version {
+    __u32 api_version;                      /* SSD1306_IOCTL_API_VERSION */
+    __u32 reserved;
+};
+
+/**
+ * @brief Text cursor position used by the next appended text
+ */
+struct ssd1306_cursor {
+    __u32 line;                             /* 0 to SSD1306_TEXT_LINES - 1 */
+    __u32 column;                           /* 0 to SSD1306_TEXT_COLUMNS - 1 */
+};
+
+/**
+ * @brief Bitmap blit request
+ *
+ * The bitmap is 1 bit per pixel, row-major, most significant bit is the
+ * leftmost pixel (PBM P4 layout). Set bits light pixels, clear bits turn
+ * them off; pixels outside the rectangle are left untouched.
+ */
+struct ssd1306_blit {
+    struct ssd1306_rect rect;               /* Destination in panel pixels */
+    __u32 stride;                           /* Bytes per bitmap row */
+    __u32 reserved;                         /* Must be zero */
+    __u64 data_ptr;                         /* Userspace bitmap, stride * height bytes */
+};
+
+/* Batch operation codes */
+#define SSD1306_OP_SET_CONTRAST     1      /* arg.value: 0-255 */
+#define SSD1306_OP_SET_INVERT       2      /* arg.value: 0 normal, 1 inverted */
+#define SSD1306_OP_SET_POWER        3      /* arg.value: 0 off, 1 on */
+#define SSD1306_OP_SET_CURSOR       4      /* arg.cursor */
+#define SSD1306_OP_BLIT             5      /* arg.blit */
+
+/**
+ * @brief One operation of a BATCH request
+ */
+struct ssd1306_op {
+    __u32 opcode;                           /* SSD1306_OP_* */
+    __u32 reserved;                         /* Must be zero */
+    union {
+        __u32 value;
+        struct ssd1306_cursor cursor;
+        struct ssd1306_blit blit;
+    } arg;
+};
+
+/**
+ * @brief BATCH request
+ *
+ * Operations run in order and stop at the first failure. Display
+ * settings take effect immediately, blitted pixels are sent with a
+ * single flush after the last operation.
+ */
+struct ssd1306_batch {
+    __u32 op_count;                         /* Entries at ops_ptr */
+    __u32 reserved;                         /* Must be zero */
+    __u64 ops_ptr;                          /* Userspace struct ssd1306_op array */
+};
+
+/* ioctl commands */
+#define SSD1306_IOCTL_MAGIC         'S'
+#define SSD1306_IOCTL_FLUSH         _IOW(SSD1306_IOCTL_MAGIC, 1, struct ssd1306_flush_request)
+#define SSD1306_IOCTL_GET_FRAME_INFO _IOR(SSD1306_IOCTL_MAGIC, 2, struct ssd1306_frame_info)
+#define SSD1306_IOCTL_SET_TICKER    _IOW(SSD1306_IOCTL_MAGIC, 3, struct ssd1306_ticker)
+#define SSD1306_IOCTL_GET_TICKER    _IOR(SSD1306_IOCTL_MAGIC, 4, struct ssd1306_ticker)
+#define SSD1306_IOCTL_SET_WRITE_MODE _IOW(SSD1306_IOCTL_MAGIC, 5, __u32)
+#define SSD1306_IOCTL_GET_VERSION   _IOR(SSD1306_IOCTL_MAGIC, 6, struct ssd1306_version)
+#define SSD1306_IOCTL_SET_CONTRAST  _IOW(SSD1306_IOCTL_MAGIC, 7, __u32)
+#define SSD1306_IOCTL_SET_INVERT    _IOW(SSD1306_IOCTL_MAGIC, 8, __u32)
+#define SSD1306_IOCTL_SET_POWER     _IOW(SSD1306_IOCTL_MAGIC, 9, __u32)
+#define SSD1306_IOCTL_SET_CURSOR    _IOW(SSD1306_IOCTL_MAGIC, 10, struct ssd1306_cursor)
+#define SSD1306_IOCTL_BLIT          _IOW(SSD1306_IOCTL_MAGIC, 11, struct ssd1306_blit)
+#define SSD1306_IOCTL_BATCH         _IOW(SSD1306_IOCTL_MAGIC, 12, struct ssd1306_batch)
+#define SSD1306_IOCTL_SET_DOUBLE_BUFFER _IOW(SSD1306_IOCTL_MAGIC, 13, __u32)
+#define SSD1306_IOCTL_FLIP          _IOR(SSD1306_IOCTL_MAGIC, 14, __u64)
+
+#endif /* SSD1306_IOCTL_H */
@@ -0,0 +1,145 @@
+/**
+ * @file ssd1306_trace.h
+ * @brief SSD1306 OLED Display Driver Tracepoints
+ * @author TungNHS
+ * @version 1.0
+ *
+ * Trace events for every I2C transfer and flush, enabled with
+ * trace-cmd/perf under the "ssd1306" system. Each event carries the
+ * adapter number and client address so it lines up with the core
+ * i2c:i2c_write events of the same bus.
+ */
+
+#undef TRACE_SYSTEM
+#define TRACE_SYSTEM ssd1306
+
+#if !defined(SSD1306_TRACE_H) || defined(TRACE_HEADER_MULTI_READ)
+#define SSD1306_TRACE_H
+
+#include <linux/i2c.h>
+#include <linux/tracepoint.h>
+
+/**
+ * @brief One command transfer (0x00 control byte) and its result
+ */
+TRACE_EVENT(ssd1306_command,
+    TP_PROTO(const struct i2c_client *client, const uint8_t *command_bytes,
+             size_t command_count, int result),
+
+    TP_ARGS(client, command_bytes, command_count, result),
+
+    TP_STRUCT__entry(
+        __field(int, adapter_nr)
+        __field(u16, addr)
+        __field(int, result)
+        __dynamic_array(u8, command_bytes, command_count)
+    ),
+
+    TP_fast_assign(
+        __entry->adapter_nr = client->adapter->nr;
+        __entry->addr = client->addr;
+        __entry->result = result;
+        memcpy(__get_dynamic_array(command_bytes), command_bytes, command_count);
+    ),
+
+    TP_printk("i2c-%d a=%03x cmd=[%s] result=%d",
+              __entry->adapter_nr, __entry->addr,
+              __print_hex(__get_dynamic_array(command_bytes),
+                          __get_dynamic_array_len(command_bytes)),
+              __entry->result)
+);
+
+/**
+ * @brief One GDDRAM data burst (0x40 control byte) and its result
+ */
+TRACE_EVENT(ssd1306_data_burst,
+    TP_PROTO(const struct i2c_client *client, size_t data_length, int result),
+
+    TP_ARGS(client, data_length, result),
+
+    TP_STRUCT__entry(
+        __field(int, adapter_nr)
+        __field(u16, addr)
+        __field(size_t, data_length)
+        __field(int, result)
+    ),
+
+    TP_fast_assign(
+        __entry->adapter_nr = client->adapter->nr;
+        __entry->addr = client->addr;
+        __entry->data_length = data_length;
+        __entry->result = result;
+    ),
+
+    TP_printk("i2c-%d a=%03x len=%zu result=%d",
+              __entry->adapter_nr, __entry->addr, __entry->data_length, __entry->result)
+);
+
+/**
+ * @brief Flush worker picked up a snapshot of the dirty pages
+ */
+TRACE_EVENT(ssd1306_flush_start,
+    TP_PROTO(const struct i2c_client *client, u64 frame_sequence,
+             unsigned int dirty_pages, size_t data_bytes),
+
+    TP_ARGS(client, frame_sequence, dirty_pages, data_bytes),
+
+    TP_STRUCT__entry(
+        __field(int, adapter_nr)
+        __field(u16, addr)
+        __field(u64, frame_sequence)
+        __field(unsigned int, dirty_pages)
+        __field(size_t, data_bytes)
+    ),
+
+    TP_fast_assign(
+        __entry->adapter_nr = client->adapter->nr;
+        __entry->addr = client->addr;
+        __entry->frame_sequence = frame_sequence;
+        __entry->dirty_pages = dirty_pages;
+        __entry->data_bytes = data_bytes;
+    ),
+
+    TP_printk("i2c-%d a=%03x frame=%llu pages=%u bytes=%zu",
+              __entry->adapter_nr, __entry->addr, __entry->frame_sequence,
+              __entry->dirty_pages, __entry->data_bytes)
+);
+
+/**
+ * @brief Flush finished, data_bytes counts GDDRAM bytes actually sent
+ */
+TRACE_EVENT(ssd1306_flush_end,
+    TP_PROTO(const struct i2c_client *client, u64 frame_sequence,
+             size_t data_bytes, int result),
+
+    TP_ARGS(client, frame_sequence, data_bytes, result),
+
+    TP_STRUCT__entry(
+        __field(int, adapter_nr)
+        __field(u16, addr)
+        __field(u64, frame_sequence)
+        __field(size_t, data_bytes)
+        __field(int, result)
+    ),
+
+    TP_fast_assign(
+        __entry->adapter_nr = client->adapter->nr;
+        __entry->addr = client->addr;
+        __entry->frame_sequence = frame_sequence;
+        __entry->data_bytes = data_bytes;
+        __entry->result = result;
+    ),
+
+    TP_printk("i2c-%d a=%03x frame=%llu bytes=%zu result=%d",
+              __entry->adapter_nr, __entry->addr, __entry->frame_sequence,
+              __entry->data_bytes, __entry->result)
+);
+
+#endif /* SSD1306_TRACE_H */
+
+/* This part must be outside protection */
+#undef TRACE_INCLUDE_PATH
+#define TRACE_INCLUDE_PATH .
+#undef TRACE_INCLUDE_FILE
+#define TRACE_INCLUDE_FILE ssd1306_trace
+#include <trace/define_trace.h>
@@ -17,7 +17,7 @@
 #include <sys/stat.h>
 
 /* Device file path */
-#define SSD1306_DEVICE_PATH "/dev/ssd1306"
+#define SSD1306_DEVICE_PATH "/dev/ssd1306-0"
 
 /* Application constants */
 #define MAX_INPUT_LENGTH       256